@@ -0,0 +1,637 @@
+////////////////////////////////
+//~NOTE(tbt): application
+
+// NOTE(tbt): the screens of the program, built with the UI each frame. the drawing is recorded in to a
+//            RenderFrame, which the platform layer either hands to the render thread (main.c) or has drawn
+//            straight away (AppUpdateAndRender()). input arrives through g_ui_state
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    WINDOW_DIMENSIONS_X = 720,
+    WINDOW_DIMENSIONS_Y = 480,
+    
+    // NOTE(tbt): frames driven by a stream of input (e.g. the mouse moving) or by the previous frame are drawn
+    //            at most this often. clicks and key presses are always drawn straight away
+    APP_MAX_FRAMES_PER_SECOND = 120,
+    
+    FRAME_PROFILE_HISTORY_COUNT = 256, // NOTE(tbt): frames of timings kept by the frame profile
+    FRAME_PROFILE_GRAPH_BARS_COUNT = 120,
+    FRAME_PROFILE_GRAPH_HEIGHT = 40,   // NOTE(tbt): a frame which takes twice the frame budget fills the graph
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef enum ProgramMode{
+    PROGRAM_STATE_MENU,
+    PROGRAM_STATE_CALCULATE_CHECK_DIGIT,
+    PROGRAM_STATE_VERIFY_CODE,
+    PROGRAM_STATE_CREATE_RECEIPT,
+    PROGRAM_STATE_CHECK_STOCK,
+}ProgramMode;
+
+typedef struct FramePacingStats{
+    uint64_t frames_count;
+    uint64_t idle_frames_count;    // NOTE(tbt): frames which turned out not to change anything
+    uint64_t wakeups_count;        // NOTE(tbt): times the main loop woke up after waiting
+    uint64_t capped_count;         // NOTE(tbt): times a frame was held back by APP_MAX_FRAMES_PER_SECOND
+    uint64_t wait_ns;              // NOTE(tbt): total time spent waiting
+    uint64_t busy_ns;              // NOTE(tbt): total time spent building and presenting frames
+    uint64_t last_frame_ns;
+    uint64_t max_frame_ns;
+    uint64_t last_interval_ns;     // NOTE(tbt): from the start of the previous frame to the start of the last one
+    uint64_t latency_count;        // NOTE(tbt): input-to-present latency, from the oldest input a frame handled
+    uint64_t total_latency_ns;
+    uint64_t last_latency_ns;
+    uint64_t max_latency_ns;
+}FramePacingStats;
+
+// NOTE(tbt): decides when the main loop should draw a frame, so it can sleep the rest of the time. the UI
+//            is immediate mode, so it needs a frame after any input, and another after any frame which
+//            changed something (e.g. a click which switched screens) until the screen settles
+typedef struct FrameScheduler{
+    bool is_frame_requested;
+    bool is_frame_urgent;          // NOTE(tbt): draw without waiting for the frame cap
+    bool is_follow_up;             // NOTE(tbt): requested because the previous frame changed something
+    uint64_t oldest_input_time;    // NOTE(tbt): the oldest input not yet presented, 0 if there isn't any
+    uint64_t last_frame_start;
+    FramePacingStats stats;
+}FrameScheduler;
+
+// NOTE(tbt): the timings of the last FRAME_PROFILE_HISTORY_COUNT frames. when profiling isn't enabled frames
+//            aren't timed at all, so it costs one branch per frame and a couple in the renderer
+typedef struct FrameProfile{
+    bool is_enabled;
+    bool is_hud_visible;
+    FrameTiming history[FRAME_PROFILE_HISTORY_COUNT];
+    uint64_t history_count;    // NOTE(tbt): frames recorded in total - history is a ring buffer indexed by this
+}FrameProfile;
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+static bool g_is_running = true; // NOTE(tbt): true while the program is running, set to false to exit
+
+static ProgramMode g_program_mode;
+
+static char *g_inventory_path = "inventory.csv";
+static Inventory g_inventory = {0};
+static bool g_is_restock_needed; // NOTE(tbt): worked out on the way in to check stock, rather than every frame
+static bool g_is_inventory_loaded;
+
+static RenderFrame g_render_frame; // NOTE(tbt): for AppUpdateAndRender(), which draws on the calling thread
+
+static FrameProfile g_frame_profile;
+
+////////////////////////////////
+//~NOTE(tbt): frame scheduling
+
+// NOTE(tbt): is_discrete is for input which should be shown straight away (clicks, key presses) rather than
+//            input which comes in a stream (the mouse moving)
+static void
+FrameSchedulerInput(FrameScheduler *scheduler,
+                    uint64_t time,
+                    bool is_discrete){
+    scheduler->is_frame_requested = true;
+    scheduler->is_follow_up = false;
+    if(is_discrete){
+        scheduler->is_frame_urgent = true;
+    }
+    if(0 == scheduler->oldest_input_time){
+        scheduler->oldest_input_time = time;
+    }
+}
+
+// NOTE(tbt): e.g. when a background job wakes the main loop
+static void
+FrameSchedulerRequest(FrameScheduler *scheduler){
+    scheduler->is_frame_requested = true;
+    scheduler->is_follow_up = false;
+}
+
+// NOTE(tbt): how long the main loop can wait for before it has to draw a frame - 0 to draw one now, or
+//            UINT64_MAX to wait for input
+static uint64_t
+FrameSchedulerGetWait(FrameScheduler *scheduler,
+                      uint64_t time){
+    uint64_t result = UINT64_MAX;
+    if(scheduler->is_frame_requested){
+        uint64_t frame_interval = 1000000000ull / APP_MAX_FRAMES_PER_SECOND;
+        uint64_t next_frame_time = scheduler->last_frame_start + frame_interval;
+        if(scheduler->is_frame_urgent || time >= next_frame_time){
+            result = 0;
+        }else{
+            result = next_frame_time - time;
+        }
+    }
+    return result;
+}
+
+static void
+FrameSchedulerWoke(FrameScheduler *scheduler,
+                   uint64_t wait_start,
+                   uint64_t wait_end){
+    scheduler->stats.wakeups_count += 1;
+    scheduler->stats.wait_ns += wait_end - wait_start;
+}
+
+// NOTE(tbt): returns true if a frame should be drawn now, and if so starts it
+static bool
+FrameSchedulerBeginFrame(FrameScheduler *scheduler,
+                         uint64_t time){
+    bool result = false;
+    if(scheduler->is_frame_requested){
+        if(0 == FrameSchedulerGetWait(scheduler, time)){
+            if(0 != scheduler->last_frame_start){
+                scheduler->stats.last_interval_ns = time - scheduler->last_frame_start;
+            }
+            scheduler->last_frame_start = time;
+            result = true;
+        }else{
+            scheduler->stats.capped_count += 1;
+        }
+    }
+    return result;
+}
+
+// NOTE(tbt): call once the frame begun by FrameSchedulerBeginFrame() has been presented. a frame which
+//            changed something asks for a follow up, which is urgent if this frame was for a click or key
+//            press - so e.g. the screen a button switches to isn't held back by the frame cap. follow ups
+//            of follow ups are capped, so something which changes every frame can't spin the loop
+static void
+FrameSchedulerEndFrame(FrameScheduler *scheduler,
+                       uint64_t time,
+                       bool is_changed){
+    FramePacingStats *stats = &scheduler->stats;
+    
+    uint64_t frame_ns = time - scheduler->last_frame_start;
+    stats->frames_count += 1;
+    stats->busy_ns += frame_ns;
+    stats->last_frame_ns = frame_ns;
+    if(frame_ns > stats->max_frame_ns){
+        stats->max_frame_ns = frame_ns;
+    }
+    if(!is_changed){
+        stats->idle_frames_count += 1;
+    }
+    
+    if(0 != scheduler->oldest_input_time){
+        uint64_t latency_ns = time - scheduler->oldest_input_time;
+        stats->latency_count += 1;
+        stats->total_latency_ns += latency_ns;
+        stats->last_latency_ns = latency_ns;
+        if(latency_ns > stats->max_latency_ns){
+            stats->max_latency_ns = latency_ns;
+        }
+        scheduler->oldest_input_time = 0;
+    }
+    
+    scheduler->is_frame_requested = is_changed;
+    scheduler->is_frame_urgent = is_changed && scheduler->is_frame_urgent && !scheduler->is_follow_up;
+    scheduler->is_follow_up = is_changed;
+}
+
+////////////////////////////////
+//~NOTE(tbt): frame profiling
+
+static void
+FrameProfileRecord(FrameTiming *timing){
+    g_frame_profile.history[g_frame_profile.history_count % FRAME_PROFILE_HISTORY_COUNT] = *timing;
+    g_frame_profile.history_count += 1;
+}
+
+// NOTE(tbt): the recorded frames, oldest first
+static size_t
+FrameProfileGetHistory(FrameTiming *result){
+    size_t count = FRAME_PROFILE_HISTORY_COUNT;
+    if(g_frame_profile.history_count < count){
+        count = g_frame_profile.history_count;
+    }
+    for(size_t i = 0;
+        i < count;
+        i += 1){
+        result[i] = g_frame_profile.history[(g_frame_profile.history_count - count + i) % FRAME_PROFILE_HISTORY_COUNT];
+    }
+    return count;
+}
+
+static uint64_t
+FrameTimingTotal(FrameTiming *timing){
+    return timing->build_ns + timing->rasterise_ns + timing->present_ns;
+}
+
+static int
+CompareUInt64s(const void *a, const void *b){
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// NOTE(tbt): the 50th and 99th percentile of the total time of the recorded frames
+static void
+FrameProfileGetPercentiles(uint64_t *p50_ns,
+                           uint64_t *p99_ns){
+    FrameTiming history[FRAME_PROFILE_HISTORY_COUNT];
+    uint64_t totals[FRAME_PROFILE_HISTORY_COUNT];
+    size_t count = FrameProfileGetHistory(history);
+    for(size_t i = 0;
+        i < count;
+        i += 1){
+        totals[i] = FrameTimingTotal(&history[i]);
+    }
+    qsort(totals, count, sizeof(totals[0]), CompareUInt64s);
+    *p50_ns = (count > 0) ? totals[count / 2] : 0;
+    *p99_ns = (count > 0) ? totals[(count*99) / 100] : 0;
+}
+
+// NOTE(tbt): writes the recorded frames to path as csv, oldest first
+static bool
+FrameProfileWrite(const char *path){
+    enum{ OUTPUT_BUFFER_SIZE = 1 << 16, };
+    
+    bool is_success = false;
+    PlatformFile file = PlatformFileOpen(path, PLATFORM_FILE_MODE_WRITE);
+    if(PLATFORM_FILE_INVALID != file){
+        OutputBuffer output = {
+            .file = file,
+            .buffer = PlatformMemoryAllocate(OUTPUT_BUFFER_SIZE),
+            .size = OUTPUT_BUFFER_SIZE,
+        };
+        if(NULL != output.buffer){
+            FrameTiming history[FRAME_PROFILE_HISTORY_COUNT];
+            size_t count = FrameProfileGetHistory(history);
+            OutputBufferWriteLiteral(&output, "frame,build_ns,rasterise_ns,present_ns,widgets,commands,pixels\n");
+            for(size_t i = 0;
+                i < count;
+                i += 1){
+                OutputBufferWriteInteger(&output, history[i].frame_index);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].build_ns);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].rasterise_ns);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].present_ns);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].widgets_count);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].commands_count);
+                OutputBufferWriteLiteral(&output, ",");
+                OutputBufferWriteInteger(&output, history[i].pixels_count);
+                OutputBufferWriteLiteral(&output, "\n");
+            }
+            OutputBufferFlush(&output);
+            is_success = !output.is_error;
+            PlatformMemoryRelease(output.buffer, OUTPUT_BUFFER_SIZE);
+        }
+        PlatformFileClose(file);
+    }
+    return is_success;
+}
+
+// NOTE(tbt): an overlay in the top right of the window, built with the rest of the UI so it is drawn the
+//            same way. the HUD changes every frame, so while it is visible frames are drawn continuously
+//            (at most APP_MAX_FRAMES_PER_SECOND). its drawing shows up in the timings, but not its widgets
+static void
+FrameProfileHUD(void){
+    enum{
+        BAR_WIDTH = 3,
+        HUD_WIDTH = FRAME_PROFILE_GRAPH_BARS_COUNT*BAR_WIDTH,
+        HUD_MIN_X = WINDOW_DIMENSIONS_X - UI_PADDING*2 - HUD_WIDTH,
+        HUD_MIN_Y = UI_PADDING*2,
+        GRAPH_MIN_Y = HUD_MIN_Y + UI_ROW_HEIGHT*5 + UI_PADDING*2,
+        GRAPH_MAX_Y = GRAPH_MIN_Y + FRAME_PROFILE_GRAPH_HEIGHT,
+    };
+    
+    FrameTiming history[FRAME_PROFILE_HISTORY_COUNT];
+    size_t count = FrameProfileGetHistory(history);
+    FrameTiming last = (count > 0) ? history[count - 1] : (FrameTiming){ 0 };
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    FrameProfileGetPercentiles(&p50_ns, &p99_ns);
+    
+    UIRectangle("frame profile background", (Pixel){ 20, 20, 20 },
+                (int[2]){ HUD_MIN_X - UI_PADDING, HUD_MIN_Y - UI_PADDING },
+                (int[2]){ HUD_MIN_X + HUD_WIDTH + UI_PADDING, GRAPH_MAX_Y + UI_PADDING });
+    
+    int y = HUD_MIN_Y;
+    UILabelF(HUD_MIN_X, y, "frame p50 %8.3f ms", p50_ns / 1e6); y += UI_ROW_HEIGHT;
+    UILabelF(HUD_MIN_X, y, "      p99 %8.3f ms", p99_ns / 1e6); y += UI_ROW_HEIGHT;
+    UILabelF(HUD_MIN_X, y, "ui %6.3f ras %6.3f", last.build_ns / 1e6, last.rasterise_ns / 1e6); y += UI_ROW_HEIGHT;
+    UILabelF(HUD_MIN_X, y, "present %6.3f ms", last.present_ns / 1e6); y += UI_ROW_HEIGHT;
+    UILabelF(HUD_MIN_X, y, "%5u wdgt %8llu px", last.widgets_count, (unsigned long long)last.pixels_count);
+    
+    // NOTE(tbt): one bar per frame, newest on the right, against the frame budget at half height
+    uint64_t budget_ns = 1000000000ull / APP_MAX_FRAMES_PER_SECOND;
+    UIRectangle("frame profile budget", (Pixel){ 90, 90, 90 },
+                (int[2]){ HUD_MIN_X, GRAPH_MAX_Y - FRAME_PROFILE_GRAPH_HEIGHT / 2 },
+                (int[2]){ HUD_MIN_X + HUD_WIDTH, GRAPH_MAX_Y - FRAME_PROFILE_GRAPH_HEIGHT / 2 + 1 });
+    size_t bars_count = (count < FRAME_PROFILE_GRAPH_BARS_COUNT) ? count : FRAME_PROFILE_GRAPH_BARS_COUNT;
+    for(size_t i = 0;
+        i < bars_count;
+        i += 1){
+        uint64_t total_ns = FrameTimingTotal(&history[count - bars_count + i]);
+        uint64_t height = (total_ns*(FRAME_PROFILE_GRAPH_HEIGHT / 2) + budget_ns - 1) / budget_ns;
+        if(height > FRAME_PROFILE_GRAPH_HEIGHT){
+            height = FRAME_PROFILE_GRAPH_HEIGHT;
+        }
+        int x = HUD_MIN_X + HUD_WIDTH - (int)(bars_count - i)*BAR_WIDTH;
+        char id[32];
+        snprintf(id, sizeof(id), "frame profile bar %zu", i);
+        UIRectangle(id, (total_ns > budget_ns) ? (Pixel){ 0, 0, 255 } : (Pixel){ 0, 200, 0 },
+                    (int[2]){ x, GRAPH_MAX_Y - (int)height },
+                    (int[2]){ x + BAR_WIDTH - 1, GRAPH_MAX_Y });
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): frames
+
+// NOTE(tbt): the screens which show the inventory load it on the way in
+static void
+AppSetMode(ProgramMode mode){
+    g_program_mode = mode;
+    if(PROGRAM_STATE_CREATE_RECEIPT == mode ||
+       PROGRAM_STATE_CHECK_STOCK == mode){
+        g_is_inventory_loaded = InventoryLoad(&g_inventory, g_inventory_path);
+        g_is_restock_needed = InventoryIsRestockNeeded(&g_inventory);
+    }
+}
+
+// NOTE(tbt): build a frame of the UI, recording what it draws in to frame
+static void
+AppUpdate(RenderFrame *frame){
+    uint64_t build_start = 0;
+    if(g_frame_profile.is_enabled){
+        build_start = PlatformGetTimeNanoseconds();
+        // NOTE(tbt): the last frame built in to this RenderFrame has been presented by now
+        if(0 != frame->previous_timing.frame_index){
+            FrameProfileRecord(&frame->previous_timing);
+        }
+    }
+    
+    size_t widgets_count = 0;
+    UIPrepare();{
+        switch(g_program_mode)
+        {
+            case(PROGRAM_STATE_MENU):{
+                int y = 75;
+                int x = 200;
+                
+                UILabel("GTIN-8 UTILS\n~~~~~~~~~~~~", x, y);
+                UILabel("select an operation:", x, (y += 96));
+                if(UIButton("calculate check digit", x, (y += 24))){
+                    AppSetMode(PROGRAM_STATE_CALCULATE_CHECK_DIGIT);
+                }
+                if(UIButton("verify code", x, (y += 24))){
+                    AppSetMode(PROGRAM_STATE_VERIFY_CODE);
+                }
+                if(UIButton("create receipt", x, (y += 24))){
+                    AppSetMode(PROGRAM_STATE_CREATE_RECEIPT);
+                }
+                if(UIButton("check stock", x, (y += 24))){
+                    AppSetMode(PROGRAM_STATE_CHECK_STOCK);
+                }
+                if(UIButton("quit", x, (y += 24))){
+                    g_is_running = false;
+                }
+            }break;
+            
+            case(PROGRAM_STATE_CALCULATE_CHECK_DIGIT):{
+                UILabel("calculate check digit", 80, UI_PADDING*2);
+                if(UIButton("back", UI_PADDING*2, UI_PADDING*2)){
+                    AppSetMode(PROGRAM_STATE_MENU);
+                }
+                UILabel("input first 7 digits:", 34, 196);
+                char *input = UILineEdit("calculate check digit entry", 375, 196, 7);
+                UILabel("full code:", 34 + 176, 220);
+                char output[9];
+                GTIN8FromFirst7Digits(output, input);
+                UILabel(output, 375, 220);
+            }break;
+            
+            case(PROGRAM_STATE_VERIFY_CODE):{
+                UILabel("verify code", 80, UI_PADDING*2);
+                if(UIButton("back", UI_PADDING*2, UI_PADDING*2)){
+                    AppSetMode(PROGRAM_STATE_MENU);
+                }
+                UILabel("input GTIN-8 code:", 82, 196);
+                char *input = UILineEdit("verify code entry", 375, 196, 8);
+                GTIN8VerifyResult result = GTIN8Verify(input);
+                if(VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING == result){
+                    UILabel("malformed input string", 82, 220);
+                }else if(VERIFY_GTIN8_RESULT_FAILURE == result){
+                    UILabel("invalid code :(", 82, 220);
+                }else if(VERIFY_GTIN8_RESULT_SUCCESS == result){
+                    UILabel("valid code :)", 82, 220);
+                }
+            }break;
+            
+            case(PROGRAM_STATE_CREATE_RECEIPT):{
+                static Receipt receipt = {0};
+                
+                UILabel("create receipt", 80, UI_PADDING*2);
+                if(UIButton("back", UI_PADDING*2, UI_PADDING*2)){
+                    ReceiptClear(&receipt);
+                    AppSetMode(PROGRAM_STATE_MENU);
+                }
+                
+                static int qty = 1;
+                
+                char *input_gtin8_code = UILineEdit("receipt add item entry", 25, 48, 8);
+                int max_qty;{
+                    size_t item_index = InventoryItemFromGTIN8Code(&g_inventory, input_gtin8_code);
+                    max_qty = g_inventory.qtys[item_index];
+                }
+                UIRectangle("receipt qty background",
+                            (Pixel){ 119, 120, 120 },
+                            (int[]){ 155, 46 },
+                            (int[]){ 228, 66 });
+                UILabelF(167, 48, "* %d", qty);
+                if(UIButton("+", 210, 68) && qty < max_qty){
+                    qty += 1;
+                }
+                if(UIButton("-", 190, 68) && qty > 1){
+                    qty -= 1;
+                }
+                ReceiptLine *line_added = NULL;
+                if(UIButton("add", 240, 48)){
+                    line_added = ReceiptPushLine(&receipt);
+                    if(NULL != line_added){
+                        line_added->item_index = InventoryItemFromGTIN8Code(&g_inventory, input_gtin8_code);
+                        line_added->qty = qty;
+                    }
+                    memset(input_gtin8_code, 0, MAX_UI_WIDGET_TEXT);
+                    qty = 1;
+                }
+                
+                // NOTE(tbt): the total is kept up to date as lines are added, so that only the visible lines need
+                //            looking at each frame
+                static Money total = 0;
+                if(0 == receipt.lines_count){
+                    total = 0;
+                }
+                if(NULL != line_added && RECEIPT_ITEM_ERROR_NONE == g_inventory.errors[line_added->item_index]){
+                    total += line_added->qty*g_inventory.unit_prices[line_added->item_index];
+                }
+                
+                UIListRows rows = UIList("receipt lines", (int[]){ UI_PADDING*2, 100 }, (int[]){ WINDOW_DIMENSIONS_X - UI_PADDING*2, 372 }, receipt.lines_count);
+                int y = rows.y;
+                for(size_t i = rows.first_row;
+                    i < rows.end_row;
+                    i += 1){
+                    int x = rows.x;
+                    size_t item_index = receipt.lines[i].item_index;
+                    ReceiptItemError error = g_inventory.errors[item_index];
+                    if(RECEIPT_ITEM_ERROR_NONE == error){
+                        Money sub_total = receipt.lines[i].qty*g_inventory.unit_prices[item_index];
+                        
+                        // NOTE(tbt): had to use $ instead of £ as £ symbol not in ASCII
+                        char unit_price_string[MONEY_STRING_SIZE];
+                        char sub_total_string[MONEY_STRING_SIZE];
+                        UILabelF(x, y, "%8.8s|%18.18s|%2d|$%s|$%s",
+                                 g_inventory.codes[item_index].digits,
+                                 InventoryItemName(&g_inventory, item_index),
+                                 receipt.lines[i].qty,
+                                 StringFromMoney(unit_price_string, g_inventory.unit_prices[item_index]),
+                                 StringFromMoney(sub_total_string, sub_total));
+                    }else if(RECEIPT_ITEM_ERROR_PARSE_ERROR == error){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("error parsing item from inventory file", x, y);
+                        UIPopColour();
+                    }
+                    else if(RECEIPT_ITEM_ERROR_INVALID_GTIN8_CODE == error){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("invalid GTIN-8 code", x, y);
+                        UIPopColour();
+                    }
+                    else if(RECEIPT_ITEM_ERROR_ITEM_NOT_FOUND == error){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("item not found", x, y);
+                        UIPopColour();
+                    }
+                    y += UI_ROW_HEIGHT;
+                }
+                
+                y = 396;
+                char total_string[MONEY_STRING_SIZE];
+                UILabelF(UI_PADDING*2 + 440, y, "total: %s", StringFromMoney(total_string, total));
+                
+                y += 24;
+                if(UIButton("save", UI_PADDING*2 + 440, y)){
+                    InventoryJournal journal;
+                    InventoryJournalBegin(&journal, g_inventory_path);
+                    for(size_t i = 0;
+                        i < receipt.lines_count;
+                        i += 1){
+                        size_t item_index = receipt.lines[i].item_index;
+                        InventorySetQty(&g_inventory, &journal, item_index, g_inventory.qtys[item_index] - receipt.lines[i].qty);
+                    }
+                    InventoryJournalEnd(&g_inventory, &journal, g_inventory_path);
+                    ReceiptClear(&receipt);
+                }
+            } break;
+            
+            case(PROGRAM_STATE_CHECK_STOCK):{
+                UILabel("check stock", 80, UI_PADDING*2);
+                if(UIButton("back", UI_PADDING*2, UI_PADDING*2)){
+                    AppSetMode(PROGRAM_STATE_MENU);
+                }
+                if(!g_is_inventory_loaded){
+                    UIPushColour((Pixel){ 0, 0, 255 });
+                    UILabelF(UI_PADDING*2, 60, "couldn't load %s", g_inventory_path);
+                    UIPopColour();
+                }
+                
+                size_t items_count = (g_inventory.items_count > DUMMY_INVENTORY_ITEM_MAX) ? g_inventory.items_count - DUMMY_INVENTORY_ITEM_MAX : 0;
+                UIListRows rows = UIList("stock items", (int[]){ UI_PADDING*2, 100 }, (int[]){ WINDOW_DIMENSIONS_X - UI_PADDING*2, 420 }, items_count);
+                int y = rows.y;
+                for(size_t i = DUMMY_INVENTORY_ITEM_MAX + rows.first_row;
+                    i < DUMMY_INVENTORY_ITEM_MAX + rows.end_row;
+                    i += 1){
+                    int x = rows.x;
+                    if(RECEIPT_ITEM_ERROR_NONE == g_inventory.errors[i]){
+                        if(g_inventory.qtys[i] < g_inventory.restock_levels[i]){
+                            UIPushColour((Pixel){ 0, 75, 255 });
+                        }else{
+                            UIPushColour((Pixel){ 0, 255, 0 });
+                        }
+                        UILabelF(x, y, "%8.8s|%18.18s|%3d|%2d|%3d",
+                                 g_inventory.codes[i].digits,
+                                 InventoryItemName(&g_inventory, i),
+                                 g_inventory.qtys[i],
+                                 g_inventory.restock_levels[i],
+                                 g_inventory.target_stocks[i]);
+                        UIPopColour();
+                    }else if(RECEIPT_ITEM_ERROR_PARSE_ERROR == g_inventory.errors[i]){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("error parsing item from inventory file", x, y);
+                        UIPopColour();
+                    }
+                    else if(RECEIPT_ITEM_ERROR_INVALID_GTIN8_CODE == g_inventory.errors[i]){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("invalid GTIN-8 code", x, y);
+                        UIPopColour();
+                    }
+                    else if(RECEIPT_ITEM_ERROR_ITEM_NOT_FOUND == g_inventory.errors[i]){
+                        UIPushColour((Pixel){ 0, 0, 255 });
+                        UILabel("item not found", x, y);
+                        UIPopColour();
+                    }
+                    y += UI_ROW_HEIGHT;
+                }
+                if(g_is_restock_needed){
+                    if(UIButton("order_restock", UI_PADDING*2 + 440, 436)){
+                        char path[PLATFORM_MAX_PATH];
+                        if(PlatformSaveFileDialogue("csv", path, sizeof(path))){
+                            InventoryOrderRestock(&g_inventory, path, g_inventory_path);
+                            g_is_restock_needed = InventoryIsRestockNeeded(&g_inventory);
+                        }
+                    }
+                }
+            } break;
+        }
+        
+        widgets_count = g_ui_state.widgets_count;
+        if(g_frame_profile.is_hud_visible){
+            FrameProfileHUD();
+        }
+    }UIFinish(frame);
+    
+    if(g_frame_profile.is_enabled){
+        frame->timing.frame_index = g_ui_state.frame_index;
+        frame->timing.build_ns = PlatformGetTimeNanoseconds() - build_start;
+        frame->timing.widgets_count = widgets_count;
+        frame->timing.commands_count = frame->list.commands_count;
+        for(size_t i = 0;
+            i < frame->damage_count;
+            i += 1){
+            Rect *damage = &frame->damage[i];
+            frame->timing.pixels_count += (uint64_t)(damage->max[0] - damage->min[0])*(damage->max[1] - damage->min[1]);
+        }
+    }
+}
+
+// NOTE(tbt): build a frame and draw it in to framebuffer straight away, on this thread
+static void
+AppUpdateAndRender(Framebuffer *framebuffer){
+    g_render_frame.width = framebuffer->width;
+    g_render_frame.height = framebuffer->height;
+    AppUpdate(&g_render_frame);
+    
+    bool is_timed = (0 != g_render_frame.timing.frame_index);
+    uint64_t rasterise_start = is_timed ? PlatformGetTimeNanoseconds() : 0;
+    RenderListExecute(&g_render_frame.list, framebuffer);
+    if(is_timed){
+        g_render_frame.timing.rasterise_ns = PlatformGetTimeNanoseconds() - rasterise_start;
+    }
+    g_render_frame.previous_timing = g_render_frame.timing;
+    g_render_frame.timing = (FrameTiming){ 0 };
+}
+
+static void
+AppShutdown(void){
+    // NOTE(tbt): let a compaction of the inventory journal finish before exiting
+    InventoryCompactionWait(&g_inventory);
+}
@@ -0,0 +1,713 @@
+////////////////////////////////
+//~NOTE(tbt): benchmarks
+
+// NOTE(tbt): micro and macro benchmarks of the hot paths, over synthetic inventories of increasing size:
+//
+//              gtin8_bench [--max-items <n>] [--min-time-ms <n>] [--dir <path>] [--output <results csv>]
+//                          [--baseline <results csv>] [--threshold <percent>] [--filter <substring>]
+//
+//            inventories of 1K items and each power of ten up to --max-items (1M by default) are generated in
+//            to --dir by dataset.c, with a fixed seed so every run sees the same data. every benchmark is run
+//            as a number of timed samples, each a fixed amount of work, until both a minimum number of samples
+//            and --min-time-ms have been reached. percentiles are over the per-op time of each sample.
+//
+//            results are printed and written as csv. given a --baseline from another build, the median of
+//            each benchmark is compared against it, and the exit code is 1 if any got slower by more than
+//            --threshold percent
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include "platform.h"
+#if defined(_WIN32)
+# include "win32_platform.c"
+#else
+# include "posix_platform.c"
+#endif
+#include "gtin8_core.c"
+#include "renderer.c"
+#include "ui.c"
+#include "app.c"
+#include "dataset.c"
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    BENCH_MIN_SAMPLES = 5,
+    BENCH_MAX_SAMPLES = 1000,
+    BENCH_MAX_RESULTS = 256,
+    BENCH_MAX_NAME = 64,
+    BENCH_MIN_ITEMS = 1000,
+    BENCH_LOOKUPS_PER_SAMPLE = 1 << 16,
+    BENCH_CODES_PER_SAMPLE = 1 << 16,
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef struct BenchResult{
+    char name[BENCH_MAX_NAME];
+    uint64_t items_count;
+    uint64_t ops_per_sample;
+    uint64_t bytes_per_sample; // NOTE(tbt): 0 if throughput doesn't make sense for the benchmark
+    int samples_count;
+    double ns_per_op_min;
+    double ns_per_op_mean;
+    double ns_per_op_p50;
+    double ns_per_op_p90;
+    double ns_per_op_p99;
+    double mb_per_s; // NOTE(tbt): at the median
+}BenchResult;
+
+typedef struct BenchContext{
+    uint64_t min_time;
+    char *filter;
+    BenchResult results[BENCH_MAX_RESULTS];
+    int results_count;
+}BenchContext;
+
+typedef void BenchFunction(void *param);
+
+// NOTE(tbt): a synthetic inventory on disk, along with codes to look up in it
+typedef struct BenchInventory{
+    size_t items_count;
+    DatasetParams dataset;
+    char csv_path[PLATFORM_MAX_PATH];
+    char output_path[PLATFORM_MAX_PATH];
+    uint64_t csv_size;
+    char (*hit_codes)[9];  // NOTE(tbt): BENCH_LOOKUPS_PER_SAMPLE codes which are in the inventory
+    char (*miss_codes)[9]; // NOTE(tbt): BENCH_LOOKUPS_PER_SAMPLE valid codes which mostly aren't
+}BenchInventory;
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+static Inventory g_bench_inventory;
+static volatile uint64_t g_bench_sink; // NOTE(tbt): results are accumulated here so the work can't be optimised out
+
+////////////////////////////////
+//~NOTE(tbt): timing
+
+static int
+CompareDoubles(const void *a,
+               const void *b){
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double
+Percentile(double *sorted,
+           int count,
+           double percentile){
+    int index = (int)(percentile/100.0*(count - 1) + 0.5);
+    return sorted[index];
+}
+
+// NOTE(tbt): call function once to warm up, then time samples of it until there are enough. each call is
+//            ops_per_sample ops, processing bytes_per_sample bytes
+static void
+BenchRun(BenchContext *context,
+         char *name,
+         uint64_t items_count,
+         uint64_t ops_per_sample,
+         uint64_t bytes_per_sample,
+         BenchFunction *function,
+         void *param){
+    if((NULL != context->filter && NULL == strstr(name, context->filter)) ||
+       context->results_count >= BENCH_MAX_RESULTS){
+        return;
+    }
+
+    function(param);
+
+    static double samples[BENCH_MAX_SAMPLES];
+    int samples_count = 0;
+    uint64_t total_time = 0;
+    while(samples_count < BENCH_MAX_SAMPLES &&
+          (samples_count < BENCH_MIN_SAMPLES || total_time < context->min_time)){
+        uint64_t start = PlatformGetTimeNanoseconds();
+        function(param);
+        uint64_t elapsed = PlatformGetTimeNanoseconds() - start;
+        samples[samples_count] = (double)elapsed / ops_per_sample;
+        samples_count += 1;
+        total_time += elapsed;
+    }
+
+    qsort(samples, samples_count, sizeof(samples[0]), CompareDoubles);
+
+    BenchResult *result = &context->results[context->results_count];
+    context->results_count += 1;
+    memset(result, 0, sizeof(*result));
+    snprintf(result->name, sizeof(result->name), "%s", name);
+    result->items_count = items_count;
+    result->ops_per_sample = ops_per_sample;
+    result->bytes_per_sample = bytes_per_sample;
+    result->samples_count = samples_count;
+    result->ns_per_op_min = samples[0];
+    result->ns_per_op_mean = (double)total_time / samples_count / ops_per_sample;
+    result->ns_per_op_p50 = Percentile(samples, samples_count, 50.0);
+    result->ns_per_op_p90 = Percentile(samples, samples_count, 90.0);
+    result->ns_per_op_p99 = Percentile(samples, samples_count, 99.0);
+    if(bytes_per_sample > 0){
+        result->mb_per_s = (double)bytes_per_sample / (result->ns_per_op_p50*ops_per_sample) * 1.0e9 / (1 << 20);
+    }
+
+    printf("%-30s %10llu %14.1f %14.1f %14.1f %14.1f",
+           result->name,
+           (unsigned long long)result->items_count,
+           result->ns_per_op_min,
+           result->ns_per_op_p50,
+           result->ns_per_op_p90,
+           result->ns_per_op_p99);
+    if(bytes_per_sample > 0){
+        printf(" %10.1f\n", result->mb_per_s);
+    }else{
+        printf(" %10s\n", "-");
+    }
+    fflush(stdout);
+}
+
+////////////////////////////////
+//~NOTE(tbt): synthetic inventories
+
+// NOTE(tbt): xorshift64* - fixed seeds, so every run benchmarks the same data
+static uint64_t
+BenchRandom(uint64_t *state){
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ull;
+}
+
+// NOTE(tbt): items_count items with distinct, valid codes, from the dataset generator
+static bool
+BenchInventoryMake(BenchInventory *bench_inventory,
+                   char *directory,
+                   size_t items_count){
+    bool is_success = false;
+
+    bench_inventory->items_count = items_count;
+    bench_inventory->dataset = (DatasetParams){
+        .seed = 1,
+        .items_count = items_count,
+    };
+    snprintf(bench_inventory->csv_path, sizeof(bench_inventory->csv_path), "%s/bench_inventory_%zu.csv", directory, items_count);
+    snprintf(bench_inventory->output_path, sizeof(bench_inventory->output_path), "%s/bench_inventory_%zu.out.csv", directory, items_count);
+    bench_inventory->hit_codes = calloc(BENCH_LOOKUPS_PER_SAMPLE, sizeof(bench_inventory->hit_codes[0]));
+    bench_inventory->miss_codes = calloc(BENCH_LOOKUPS_PER_SAMPLE, sizeof(bench_inventory->miss_codes[0]));
+
+    if(NULL != bench_inventory->hit_codes && NULL != bench_inventory->miss_codes &&
+       DatasetGenerateInventory(&bench_inventory->dataset, bench_inventory->csv_path)){
+        uint64_t random_state = 0x9e3779b97f4a7c15ull ^ items_count;
+        for(size_t i = 0;
+            i < BENCH_LOOKUPS_PER_SAMPLE;
+            i += 1){
+            DatasetItemCode(&bench_inventory->dataset, BenchRandom(&random_state) % items_count, bench_inventory->hit_codes[i]);
+            DatasetCodeFromPrefix(BenchRandom(&random_state) % GTIN8_PREFIX_MAX, bench_inventory->miss_codes[i]);
+        }
+
+        uint64_t write_time;
+        is_success = PlatformGetFileSizeAndWriteTime(bench_inventory->csv_path, &bench_inventory->csv_size, &write_time);
+    }
+
+    return is_success;
+}
+
+static void
+BenchInventoryRelease(BenchInventory *bench_inventory){
+    free(bench_inventory->hit_codes);
+    free(bench_inventory->miss_codes);
+    PlatformFileDelete(bench_inventory->csv_path);
+    PlatformFileDelete(bench_inventory->output_path);
+
+    char snapshot_path[PLATFORM_MAX_PATH];
+    InventorySnapshotPathFromCSVPath(bench_inventory->csv_path, snapshot_path, sizeof(snapshot_path));
+    PlatformFileDelete(snapshot_path);
+
+    memset(bench_inventory, 0, sizeof(*bench_inventory));
+}
+
+////////////////////////////////
+//~NOTE(tbt): GTIN-8 benchmarks
+
+typedef struct BenchCodes{
+    char (*codes)[9];  // NOTE(tbt): null terminated, for the single code functions
+    char *packed;      // NOTE(tbt): back to back, for the batch functions
+    int8_t *results;
+}BenchCodes;
+
+static void
+BenchGTIN8Verify(void *param){
+    BenchCodes *codes = param;
+    uint64_t valid_count = 0;
+    for(size_t i = 0;
+        i < BENCH_CODES_PER_SAMPLE;
+        i += 1){
+        valid_count += (VERIFY_GTIN8_RESULT_SUCCESS == GTIN8Verify(codes->codes[i]));
+    }
+    g_bench_sink += valid_count;
+}
+
+static void
+BenchGTIN8FromFirst7Digits(void *param){
+    BenchCodes *codes = param;
+    uint64_t check_digits = 0;
+    for(size_t i = 0;
+        i < BENCH_CODES_PER_SAMPLE;
+        i += 1){
+        char input[8];
+        char output[9];
+        memcpy(input, codes->codes[i], 7);
+        input[7] = '\0';
+        GTIN8FromFirst7Digits(output, input);
+        check_digits += output[7];
+    }
+    g_bench_sink += check_digits;
+}
+
+static void
+BenchGTIN8VerifyBatch(void *param){
+    BenchCodes *codes = param;
+    GTIN8VerifyBatch(codes->packed, BENCH_CODES_PER_SAMPLE, codes->results);
+    g_bench_sink += codes->results[BENCH_CODES_PER_SAMPLE - 1];
+}
+
+static void
+BenchGTIN8(BenchContext *context){
+    BenchCodes codes = {
+        .codes = calloc(BENCH_CODES_PER_SAMPLE, sizeof(codes.codes[0])),
+        .packed = calloc(BENCH_CODES_PER_SAMPLE, 8),
+        .results = calloc(BENCH_CODES_PER_SAMPLE, 1),
+    };
+    if(NULL != codes.codes && NULL != codes.packed && NULL != codes.results){
+        // NOTE(tbt): about 1 in 10 random codes has the right check digit
+        uint64_t random_state = 0x2545f4914f6cdd1dull;
+        for(size_t i = 0;
+            i < BENCH_CODES_PER_SAMPLE;
+            i += 1){
+            snprintf(codes.codes[i], sizeof(codes.codes[i]), "%08u", (uint32_t)(BenchRandom(&random_state) % 100000000));
+            memcpy(&codes.packed[i*8], codes.codes[i], 8);
+        }
+        BenchRun(context, "gtin8_verify", 0, BENCH_CODES_PER_SAMPLE, 0, BenchGTIN8Verify, &codes);
+        BenchRun(context, "gtin8_from_first_7_digits", 0, BENCH_CODES_PER_SAMPLE, 0, BenchGTIN8FromFirst7Digits, &codes);
+        BenchRun(context, "gtin8_verify_batch", 0, BENCH_CODES_PER_SAMPLE, BENCH_CODES_PER_SAMPLE*8, BenchGTIN8VerifyBatch, &codes);
+    }
+    free(codes.codes);
+    free(codes.packed);
+    free(codes.results);
+}
+
+////////////////////////////////
+//~NOTE(tbt): inventory benchmarks
+
+static void
+BenchDatasetGenerate(void *param){
+    BenchInventory *bench_inventory = param;
+    g_bench_sink += DatasetGenerateInventory(&bench_inventory->dataset, bench_inventory->output_path);
+}
+
+static void
+BenchInventoryParse(void *param){
+    BenchInventory *bench_inventory = param;
+    InventoryParseFile(&g_bench_inventory, bench_inventory->csv_path);
+    g_bench_sink += g_bench_inventory.items_count;
+}
+
+static void
+BenchInventorySerialise(void *param){
+    BenchInventory *bench_inventory = param;
+    g_bench_sink += InventorySerialiseFile(&g_bench_inventory, bench_inventory->output_path);
+}
+
+static void
+BenchInventoryOpenSnapshot(void *param){
+    BenchInventory *bench_inventory = param;
+    g_bench_sink += InventoryOpenSnapshot(&g_bench_inventory, bench_inventory->csv_path);
+}
+
+static void
+BenchInventoryLookupHits(void *param){
+    BenchInventory *bench_inventory = param;
+    uint64_t sum = 0;
+    for(size_t i = 0;
+        i < BENCH_LOOKUPS_PER_SAMPLE;
+        i += 1){
+        sum += InventoryItemFromGTIN8Code(&g_bench_inventory, bench_inventory->hit_codes[i]);
+    }
+    g_bench_sink += sum;
+}
+
+static void
+BenchInventoryLookupMisses(void *param){
+    BenchInventory *bench_inventory = param;
+    uint64_t sum = 0;
+    for(size_t i = 0;
+        i < BENCH_LOOKUPS_PER_SAMPLE;
+        i += 1){
+        sum += InventoryItemFromGTIN8Code(&g_bench_inventory, bench_inventory->miss_codes[i]);
+    }
+    g_bench_sink += sum;
+}
+
+static void
+BenchInventoryOperations(BenchContext *context,
+                         BenchInventory *bench_inventory){
+    size_t items_count = bench_inventory->items_count;
+
+    BenchRun(context, "dataset_generate", items_count, items_count, bench_inventory->csv_size, BenchDatasetGenerate, bench_inventory);
+    BenchRun(context, "inventory_parse", items_count, items_count, bench_inventory->csv_size, BenchInventoryParse, bench_inventory);
+
+    // NOTE(tbt): the rest work on the parsed inventory
+    InventoryParseFile(&g_bench_inventory, bench_inventory->csv_path);
+
+    BenchRun(context, "inventory_serialise", items_count, items_count, bench_inventory->csv_size, BenchInventorySerialise, bench_inventory);
+    BenchRun(context, "inventory_lookup_hit", items_count, BENCH_LOOKUPS_PER_SAMPLE, 0, BenchInventoryLookupHits, bench_inventory);
+    BenchRun(context, "inventory_lookup_miss", items_count, BENCH_LOOKUPS_PER_SAMPLE, 0, BenchInventoryLookupMisses, bench_inventory);
+
+    InventoryWriteSnapshot(&g_bench_inventory, bench_inventory->csv_path);
+    BenchRun(context, "inventory_open_snapshot", items_count, 1, 0, BenchInventoryOpenSnapshot, bench_inventory);
+    BenchRun(context, "inventory_lookup_hit_snapshot", items_count, BENCH_LOOKUPS_PER_SAMPLE, 0, BenchInventoryLookupHits, bench_inventory);
+
+    InventoryClear(&g_bench_inventory);
+}
+
+////////////////////////////////
+//~NOTE(tbt): rendering benchmarks
+
+typedef struct BenchFrame{
+    Framebuffer framebuffer;
+    Pixel *image; // NOTE(tbt): framebuffer sized, to blit from
+    RenderPipeline pipeline;
+}BenchFrame;
+
+static void
+BenchFrameRender(void *param){
+    BenchFrame *frame = param;
+    AppUpdateAndRender(&frame->framebuffer);
+    g_bench_sink += frame->framebuffer.pixels[0].r;
+}
+
+// NOTE(tbt): the UI only redraws what changed, so an idle frame draws nothing - this forces every pixel to be
+//            redrawn to measure the rasteriser itself
+static void
+BenchFrameRedraw(void *param){
+    BenchFrame *frame = param;
+    UIInvalidate();
+    AppUpdateAndRender(&frame->framebuffer);
+    g_bench_sink += frame->framebuffer.pixels[0].r;
+}
+
+static void
+BenchPresentNothing(void *param,
+                    Framebuffer *framebuffer,
+                    Rect *damage,
+                    size_t damage_count){
+    g_bench_sink += damage_count;
+}
+
+// NOTE(tbt): the same as BenchFrameRedraw(), but through the render thread as main.c does it - so the UI for
+//            one frame is built while the last is drawn, and only the slower of the two is measured
+static void
+BenchFrameRedrawPipelined(void *param){
+    BenchFrame *frame = param;
+    UIInvalidate();
+    RenderFrame *render_frame = RenderPipelineBeginFrame(&frame->pipeline);
+    AppUpdate(render_frame);
+    RenderPipelineSubmitFrame(&frame->pipeline);
+}
+
+static void
+BenchFillScreen(void *param){
+    BenchFrame *frame = param;
+    FramebufferFill(&frame->framebuffer, (Pixel){ 45, 100, 45 });
+    g_bench_sink += frame->framebuffer.pixels[0].r;
+}
+
+static void
+BenchBlitScreen(void *param){
+    BenchFrame *frame = param;
+    DrawImage(&frame->framebuffer, frame->image, frame->framebuffer.width, frame->framebuffer.height, 0, 0);
+    g_bench_sink += frame->framebuffer.pixels[0].r;
+}
+
+static void
+BenchDrawString(void *param){
+    BenchFrame *frame = param;
+    for(int y = 0;
+        y < frame->framebuffer.height;
+        y += FONT_SIZE << UI_FONT_SCALE){
+        DrawString(&frame->framebuffer, "0123456789 abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOP", 0, y, UI_FONT_SCALE, (Pixel){ 255, 255, 255 });
+    }
+    g_bench_sink += frame->framebuffer.pixels[0].r;
+}
+
+// NOTE(tbt): a screen packed with small widgets, far more than any of the app's screens draw, to see how the
+//            tiled renderer copes with big lists - once through the workers and once all on this thread
+enum{ BENCH_RENDER_LIST_WIDGETS_COUNT = 4096 };
+
+typedef struct BenchRenderList{
+    BenchFrame *frame;
+    RenderList list;
+    bool is_serial;
+}BenchRenderList;
+
+static void
+BenchRenderListWidgets(void *param){
+    BenchRenderList *bench = param;
+    Framebuffer *framebuffer = &bench->frame->framebuffer;
+    Rect clip = { .max = { framebuffer->width, framebuffer->height } };
+    int columns_count = 64;
+    int widget_width = framebuffer->width / columns_count;
+    int widget_height = framebuffer->height / (BENCH_RENDER_LIST_WIDGETS_COUNT / columns_count);
+    for(int widget_index = 0;
+        widget_index < BENCH_RENDER_LIST_WIDGETS_COUNT;
+        widget_index += 1){
+        int min[2] = { (widget_index % columns_count)*widget_width, (widget_index / columns_count)*widget_height };
+        int max[2] = { min[0] + widget_width, min[1] + widget_height };
+        RenderRectangleFill(&bench->list, clip, (Pixel){ widget_index, 45, 45 }, min, max);
+        RenderString(&bench->list, clip, "1234", min[0] + 1, min[1] + 1, 0, (Pixel){ 255, 255, 255 });
+    }
+    if(bench->is_serial){
+        RenderListDraw(&bench->list, framebuffer);
+        RenderListReset(&bench->list);
+    }else{
+        RenderListExecute(&bench->list, framebuffer);
+    }
+    g_bench_sink += framebuffer->pixels[0].r;
+}
+
+static void
+BenchRendering(BenchContext *context,
+               BenchInventory *bench_inventory){
+    BenchFrame frame = {
+        .framebuffer = {
+            .width = WINDOW_DIMENSIONS_X,
+            .height = WINDOW_DIMENSIONS_Y,
+        },
+    };
+    size_t pixels_size = (size_t)frame.framebuffer.width*frame.framebuffer.height*sizeof(Pixel);
+    frame.framebuffer.pixels = PlatformMemoryAllocate(pixels_size);
+    frame.image = PlatformMemoryAllocate(pixels_size);
+
+    if(NULL != frame.framebuffer.pixels && NULL != frame.image){
+        if(NULL == bench_inventory){
+            BenchRun(context, "fill_screen", 0, 1, pixels_size, BenchFillScreen, &frame);
+            BenchRun(context, "blit_screen", 0, 1, 2*pixels_size, BenchBlitScreen, &frame);
+
+            int lines_count = frame.framebuffer.height / (FONT_SIZE << UI_FONT_SCALE);
+            BenchRun(context, "draw_string", 0, lines_count, 0, BenchDrawString, &frame);
+            
+            BenchRenderList render_list = { .frame = &frame };
+            BenchRun(context, "render_list_widgets", 0, BENCH_RENDER_LIST_WIDGETS_COUNT, pixels_size, BenchRenderListWidgets, &render_list);
+            render_list.is_serial = true;
+            BenchRun(context, "render_list_widgets_serial", 0, BENCH_RENDER_LIST_WIDGETS_COUNT, pixels_size, BenchRenderListWidgets, &render_list);
+            ArenaRelease(&render_list.list.arena);
+
+            AppSetMode(PROGRAM_STATE_MENU);
+            BenchRun(context, "ui_frame_menu", 0, 1, 0, BenchFrameRender, &frame);
+            BenchRun(context, "ui_frame_menu_redraw", 0, 1, pixels_size, BenchFrameRedraw, &frame);
+            
+            // NOTE(tbt): the image is drawn over by the pipeline, so this has to come after blit_screen
+            Framebuffer framebuffers[2] = { frame.framebuffer, frame.framebuffer };
+            framebuffers[1].pixels = frame.image;
+            RenderPipelineStart(&frame.pipeline, framebuffers, BenchPresentNothing, NULL);
+            BenchRun(context, "ui_frame_menu_redraw_pipelined", 0, 1, pixels_size, BenchFrameRedrawPipelined, &frame);
+            RenderPipelineStop(&frame.pipeline);
+
+            AppSetMode(PROGRAM_STATE_VERIFY_CODE);
+            BenchRun(context, "ui_frame_verify", 0, 1, 0, BenchFrameRender, &frame);
+            BenchRun(context, "ui_frame_verify_redraw", 0, 1, pixels_size, BenchFrameRedraw, &frame);
+        }else{
+            g_inventory_path = bench_inventory->csv_path;
+            AppSetMode(PROGRAM_STATE_CHECK_STOCK);
+            BenchRun(context, "ui_frame_check_stock", bench_inventory->items_count, 1, 0, BenchFrameRender, &frame);
+            BenchRun(context, "ui_frame_check_stock_redraw", bench_inventory->items_count, 1, pixels_size, BenchFrameRedraw, &frame);
+            AppSetMode(PROGRAM_STATE_MENU);
+            InventoryClear(&g_inventory);
+        }
+    }
+    if(NULL != frame.framebuffer.pixels){
+        PlatformMemoryRelease(frame.framebuffer.pixels, pixels_size);
+    }
+    if(NULL != frame.image){
+        PlatformMemoryRelease(frame.image, pixels_size);
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): results
+
+static bool
+BenchWriteResults(BenchContext *context,
+                  char *path){
+    bool is_success = false;
+
+    char buffer[1 << 12];
+    PlatformFile file = PlatformFileOpen(path, PLATFORM_FILE_MODE_WRITE);
+    OutputBuffer output = {
+        .file = file,
+        .buffer = buffer,
+        .size = sizeof(buffer),
+    };
+    if(PLATFORM_FILE_INVALID != file){
+        OutputBufferWriteLiteral(&output, "name,items,samples,ops_per_sample,ns_per_op_min,ns_per_op_mean,ns_per_op_p50,ns_per_op_p90,ns_per_op_p99,mb_per_s\n");
+        for(int result_index = 0;
+            result_index < context->results_count;
+            result_index += 1){
+            BenchResult *result = &context->results[result_index];
+            char line[512];
+            int length = snprintf(line, sizeof(line), "%s,%llu,%d,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                                  result->name,
+                                  (unsigned long long)result->items_count,
+                                  result->samples_count,
+                                  (unsigned long long)result->ops_per_sample,
+                                  result->ns_per_op_min,
+                                  result->ns_per_op_mean,
+                                  result->ns_per_op_p50,
+                                  result->ns_per_op_p90,
+                                  result->ns_per_op_p99,
+                                  result->mb_per_s);
+            OutputBufferWrite(&output, line, length);
+        }
+        OutputBufferFlush(&output);
+        is_success = !output.is_error;
+        PlatformFileClose(file);
+    }
+
+    return is_success;
+}
+
+// NOTE(tbt): compare medians with the same benchmark and size in a results file from another build. returns
+//            the number which got slower by more than threshold percent
+static int
+BenchCompareWithBaseline(BenchContext *context,
+                         char *path,
+                         double threshold){
+    int regressions_count = 0;
+
+    size_t size;
+    char *data = ReadEntireFileForParsing(path, &size);
+    if(NULL == data){
+        fprintf(stderr, "could not read baseline %s\n", path);
+        regressions_count = -1;
+    }else{
+        printf("\n%-30s %10s %14s %14s %9s\n", "benchmark", "items", "baseline p50", "p50", "change");
+
+        // NOTE(tbt): the file starts at data + 1, and is followed by zeroed padding so it is null terminated
+        char *line = data + 1;
+        while('\0' != *line){
+            char *line_end = strchr(line, '\n');
+            if(NULL != line_end){
+                *line_end = '\0';
+            }
+
+            char name[BENCH_MAX_NAME];
+            unsigned long long items_count;
+            double p50;
+            if(3 == sscanf(line, "%63[^,],%llu,%*d,%*u,%*f,%*f,%lf", name, &items_count, &p50)){
+                for(int result_index = 0;
+                    result_index < context->results_count;
+                    result_index += 1){
+                    BenchResult *result = &context->results[result_index];
+                    if(0 == strcmp(name, result->name) && items_count == result->items_count && p50 > 0.0){
+                        double change = (result->ns_per_op_p50 - p50) / p50 * 100.0;
+                        bool is_regression = change > threshold;
+                        printf("%-30s %10llu %14.1f %14.1f %+8.1f%%%s\n",
+                               result->name, items_count, p50, result->ns_per_op_p50, change,
+                               is_regression ? "  REGRESSION" : "");
+                        regressions_count += is_regression;
+                    }
+                }
+            }
+
+            line = (NULL != line_end) ? line_end + 1 : line + strlen(line);
+        }
+        ReleaseFileForParsing(data, size);
+    }
+
+    return regressions_count;
+}
+
+////////////////////////////////
+//~NOTE(tbt): entry point
+
+int
+main(int argc,
+     char **argv){
+    static BenchContext context;
+    context.min_time = 250*1000000ull;
+
+    size_t max_items = 1000000;
+    char *directory = ".";
+    char *output_path = "bench_results.csv";
+    char *baseline_path = NULL;
+    double threshold = 10.0;
+
+    bool is_usage_error = false;
+    for(int arg_index = 1;
+        arg_index + 1 < argc && !is_usage_error;
+        arg_index += 2){
+        char *arg = argv[arg_index];
+        char *value = argv[arg_index + 1];
+        if(0 == strcmp(arg, "--max-items")){
+            max_items = strtoull(value, NULL, 10);
+        }else if(0 == strcmp(arg, "--min-time-ms")){
+            context.min_time = strtoull(value, NULL, 10)*1000000ull;
+        }else if(0 == strcmp(arg, "--dir")){
+            directory = value;
+        }else if(0 == strcmp(arg, "--output")){
+            output_path = value;
+        }else if(0 == strcmp(arg, "--baseline")){
+            baseline_path = value;
+        }else if(0 == strcmp(arg, "--threshold")){
+            threshold = strtod(value, NULL);
+        }else if(0 == strcmp(arg, "--filter")){
+            context.filter = value;
+        }else{
+            is_usage_error = true;
+        }
+    }
+    if(is_usage_error || 0 == argc % 2){
+        fprintf(stderr,
+                "usage: %s [--max-items <n>] [--min-time-ms <n>] [--dir <path>] [--output <results csv>]\n"
+                "       %*s [--baseline <results csv>] [--threshold <percent>] [--filter <substring>]\n",
+                argv[0], (int)strlen(argv[0]), "");
+        return 1;
+    }
+
+    printf("%-30s %10s %14s %14s %14s %14s %10s\n", "benchmark", "items", "ns/op min", "ns/op p50", "ns/op p90", "ns/op p99", "MB/s");
+
+    BenchGTIN8(&context);
+    BenchRendering(&context, NULL);
+
+    for(size_t items_count = BENCH_MIN_ITEMS;
+        items_count <= max_items;
+        items_count *= 10){
+        BenchInventory bench_inventory = {0};
+        if(BenchInventoryMake(&bench_inventory, directory, items_count)){
+            BenchInventoryOperations(&context, &bench_inventory);
+
+            // NOTE(tbt): the check stock screen only builds the rows which are in view, so its frames should cost
+            //            the same whatever the size of the inventory - timed at every size to show that they do
+            BenchRendering(&context, &bench_inventory);
+        }else{
+            fprintf(stderr, "could not write a %zu item inventory to %s\n", items_count, directory);
+        }
+        BenchInventoryRelease(&bench_inventory);
+    }
+
+    AppShutdown();
+
+    int exit_code = 0;
+    if(!BenchWriteResults(&context, output_path)){
+        fprintf(stderr, "could not write results to %s\n", output_path);
+        exit_code = 1;
+    }
+    if(NULL != baseline_path && 0 != BenchCompareWithBaseline(&context, baseline_path, threshold)){
+        exit_code = 1;
+    }
+
+    return exit_code;
+}
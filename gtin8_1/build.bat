@@ -1,4 +1,5 @@
 @echo off
 
 cl /nologo main.c /DUNICODE /Zi /link /debug /incremental:no /out:gtin8_utils.exe
-del main.obj vc140.pdb
+cl /nologo /O2 bench_main.c /Zi /link /debug /incremental:no /out:gtin8_bench.exe
+del main.obj bench_main.obj vc140.pdb
@@ -0,0 +1,7 @@
+#!/bin/sh
+
+# NOTE(tbt): the headless build, for anywhere without a window system (e.g. linux)
+
+cd "$(dirname "$0")"
+${CC:-cc} -std=gnu11 -O2 -g headless_main.c -o headless_gtin8_utils -lpthread
+${CC:-cc} -std=gnu11 -O2 -g bench_main.c -o gtin8_bench -lpthread
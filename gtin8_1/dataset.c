@@ -0,0 +1,534 @@
+////////////////////////////////
+//~NOTE(tbt): synthetic datasets
+
+// NOTE(tbt): generates inventories of any size, in exactly the format InventoryParseFile() reads, along with
+//            streams of sales against them, for load testing and benchmarks.
+//
+//            everything is a pure function of the seed and the row number - each row gets its own random
+//            stream - so the output is the same however many threads write it, and any row's code can be
+//            recomputed without generating the rest (which is how sales refer to items which exist).
+//
+//            inventory rows are written in the same shape as inventory.csv:
+//
+//              <GTIN-8 code>, <name>, <unit price>, <qty>, <restock level>, <target stock>,
+//
+//            and sales one per line as:
+//
+//              <GTIN-8 code>, <qty>
+//
+//            codes walk the 10 million GTIN-8 prefixes in a shuffled order, so are distinct until there are
+//            more items than prefixes. a configurable fraction of rows reuse the code of an earlier row, fail
+//            to parse in one of a few ways, or have the wrong check digit. sales favour a small number of
+//            popular items, and a fraction are of codes which aren't in the inventory or have the wrong check
+//            digit
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    DATASET_ROWS_PER_CHUNK = 1 << 13,
+    DATASET_MAX_THREADS = 16,
+    DATASET_MAX_ROW_SIZE = 1024, // NOTE(tbt): enough for the longest row, which is one with a too long name
+};
+
+// NOTE(tbt): each kind of data gets its own random streams, so e.g. changing the number of items doesn't
+//            change anything about a row
+typedef enum DatasetStream{
+    DATASET_STREAM_CODES,
+    DATASET_STREAM_INVENTORY,
+    DATASET_STREAM_SALES,
+}DatasetStream;
+
+typedef enum DatasetCorruption{
+    DATASET_CORRUPTION_PRICE,      // NOTE(tbt): trailing junk after the unit price
+    DATASET_CORRUPTION_QTY,        // NOTE(tbt): qty isn't a number
+    DATASET_CORRUPTION_LONG_CODE,  // NOTE(tbt): 9 digit code
+    DATASET_CORRUPTION_LONG_NAME,  // NOTE(tbt): name longer than INVENTORY_MAX_NAME_SIZE
+    DATASET_CORRUPTION_EXTRA_FIELD,
+
+    DATASET_CORRUPTION_MAX
+}DatasetCorruption;
+
+// NOTE(tbt): words product names are built from
+static const char *g_dataset_words[] = {
+    "plain", "brackets", "hinges", "100mm", "bolts", "50mm", "25mm", "M6", "M8", "M10", "nuts", "washers",
+    "steel", "brass", "zinc", "plated", "galvanised", "stainless", "wood", "screws", "countersunk", "pan",
+    "head", "self", "tapping", "wall", "plugs", "heavy", "duty", "angle", "corner", "shelf", "support",
+    "cabinet", "handle", "chrome", "black", "white", "satin", "door", "knob", "pull", "hook", "eye",
+    "chain", "rope", "nylon", "cable", "ties", "clips", "tape", "masking", "duct", "glue", "epoxy",
+    "sealant", "silicone", "filler", "sandpaper", "fine", "coarse", "assorted", "pack", "of", "10",
+    "20", "100", "large", "small", "medium", "hex", "key", "set", "spanner", "drill", "bit", "HSS",
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef struct DatasetParams{
+    uint64_t seed;
+    uint64_t items_count;
+    uint64_t sales_count;
+    double duplicate_rate;    // NOTE(tbt): fraction of rows which reuse the code of an earlier row
+    double corrupt_rate;      // NOTE(tbt): fraction of rows which fail to parse
+    double invalid_code_rate; // NOTE(tbt): fraction of rows, and sales, with the wrong check digit
+    double unknown_sale_rate; // NOTE(tbt): fraction of sales of random codes, which mostly aren't in the inventory
+}DatasetParams;
+
+typedef struct DatasetRandom{
+    uint64_t state;
+}DatasetRandom;
+
+// NOTE(tbt): writes row row_index to at, returning the end. at most DATASET_MAX_ROW_SIZE bytes
+typedef char *DatasetRowFunction(DatasetParams *params, uint64_t row_index, char *at);
+
+// NOTE(tbt): a chunk of consecutive rows, formatted on its own thread in to its own buffer
+typedef struct DatasetJob{
+    DatasetParams *params;
+    DatasetRowFunction *row_function;
+    uint64_t first_row;
+    uint64_t rows_count;
+    char *buffer;
+    size_t used;
+}DatasetJob;
+
+////////////////////////////////
+//~NOTE(tbt): random numbers
+
+// NOTE(tbt): splitmix64
+static uint64_t
+DatasetRandomNext(DatasetRandom *random){
+    random->state += 0x9e3779b97f4a7c15ull;
+    uint64_t result = random->state;
+    result = (result ^ (result >> 30))*0xbf58476d1ce4e5b9ull;
+    result = (result ^ (result >> 27))*0x94d049bb133111ebull;
+    return result ^ (result >> 31);
+}
+
+static DatasetRandom
+DatasetRandomFromRow(DatasetParams *params,
+                     DatasetStream stream,
+                     uint64_t row_index){
+    DatasetRandom result = { params->seed ^ ((uint64_t)stream << 56) };
+    result.state = DatasetRandomNext(&result) + row_index*0xd1342543de82ef95ull;
+    DatasetRandomNext(&result);
+    return result;
+}
+
+// NOTE(tbt): uniform in [0, 1), from the top 53 bits so it is the same everywhere
+static double
+DatasetRandomUnit(DatasetRandom *random){
+    return (DatasetRandomNext(random) >> 11)*(1.0/9007199254740992.0);
+}
+
+static bool
+DatasetRandomChance(DatasetRandom *random,
+                    double rate){
+    return DatasetRandomUnit(random) < rate;
+}
+
+static uint64_t
+DatasetRandomBelow(DatasetRandom *random,
+                   uint64_t bound){
+    return (bound > 0) ? DatasetRandomNext(random) % bound : 0;
+}
+
+////////////////////////////////
+//~NOTE(tbt): codes
+
+// NOTE(tbt): a bijection on the prefixes - a 4 round feistel network on 24 bit numbers, with round keys from
+//            the seed, is a bijection on [0, 2^24). applying it until the result lands back under 10^7 (cycle
+//            walking, 1.7 times on average) makes it one on [0, 10^7)
+static uint32_t
+DatasetPrefixFromIndex(DatasetParams *params,
+                       uint64_t index){
+    enum{ HALF_BITS = 12, HALF_MASK = (1 << HALF_BITS) - 1, };
+
+    // NOTE(tbt): the halves are only 12 bits, so 16 bit round keys are plenty
+    DatasetRandom random = DatasetRandomFromRow(params, DATASET_STREAM_CODES, 0);
+    uint64_t key_bits = DatasetRandomNext(&random);
+    uint32_t keys[4];
+    for(int i = 0;
+        i < ARRAY_COUNT(keys);
+        i += 1){
+        keys[i] = (key_bits >> (16*i)) & 0xffff;
+    }
+
+    uint32_t result = (uint32_t)(index % GTIN8_PREFIX_MAX);
+    do{
+        uint32_t left = result >> HALF_BITS;
+        uint32_t right = result & HALF_MASK;
+        for(int i = 0;
+            i < ARRAY_COUNT(keys);
+            i += 1){
+            uint32_t mixed = (right ^ keys[i])*0x9e3779b1u;
+            uint32_t next_right = left ^ ((mixed >> 16) & HALF_MASK);
+            left = right;
+            right = next_right;
+        }
+        result = (left << HALF_BITS) | right;
+    }while(result >= GTIN8_PREFIX_MAX);
+
+    return result;
+}
+
+static void
+DatasetCodeFromPrefix(uint32_t prefix,
+                      char result[9]){
+    char digits[8];
+    digits[7] = '\0';
+    for(int i = 6;
+        i >= 0;
+        i -= 1){
+        digits[i] = '0' + prefix % 10;
+        prefix /= 10;
+    }
+    GTIN8FromFirst7Digits(result, digits);
+}
+
+static void
+DatasetCodeBreakCheckDigit(char code[9],
+                           DatasetRandom *random){
+    code[7] = '0' + (code[7] - '0' + 1 + DatasetRandomBelow(random, 9)) % 10;
+}
+
+// NOTE(tbt): the code item item_index is written with, before any corruption. duplicates take the code of
+//            an earlier item's position in the shuffled order
+static void
+DatasetItemCode(DatasetParams *params,
+                uint64_t item_index,
+                char result[9]){
+    DatasetRandom random = DatasetRandomFromRow(params, DATASET_STREAM_INVENTORY, item_index);
+    uint64_t code_index = item_index;
+    if(item_index > 0 && DatasetRandomChance(&random, params->duplicate_rate)){
+        code_index = DatasetRandomBelow(&random, item_index);
+    }
+    DatasetCodeFromPrefix(DatasetPrefixFromIndex(params, code_index), result);
+    if(DatasetRandomChance(&random, params->invalid_code_rate)){
+        DatasetCodeBreakCheckDigit(result, &random);
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): rows
+
+static char *
+DatasetWriteInteger(char *at,
+                    uint64_t value){
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *start = FormatUnsignedDecimal(end, value);
+    memcpy(at, start, end - start);
+    return at + (end - start);
+}
+
+#define DatasetWriteLiteral(AT, S) (memcpy((AT), (S), sizeof(S) - 1), (AT) + sizeof(S) - 1)
+
+// NOTE(tbt): most names are 10 to 25 characters, with a long tail out past 100 - roughly what a real
+//            product list looks like
+static char *
+DatasetWriteName(char *at,
+                 DatasetRandom *random){
+    size_t target_length = 4 + DatasetRandomBelow(random, 12) + DatasetRandomBelow(random, 12);
+    if(DatasetRandomChance(random, 0.05)){
+        target_length += DatasetRandomBelow(random, 80);
+    }
+
+    size_t length = 0;
+    while(length < target_length){
+        const char *word = g_dataset_words[DatasetRandomBelow(random, ARRAY_COUNT(g_dataset_words))];
+        size_t word_length = strlen(word);
+        if(length > 0){
+            if(length + 1 + word_length > target_length + 4){
+                break;
+            }
+            at[length] = ' ';
+            length += 1;
+        }
+        memcpy(&at[length], word, word_length);
+        length += word_length;
+    }
+
+    return at + length;
+}
+
+static char *
+DatasetWriteInventoryRow(DatasetParams *params,
+                         uint64_t row_index,
+                         char *at){
+    char code[9];
+    DatasetItemCode(params, row_index, code);
+
+    // NOTE(tbt): a separate stream from the one DatasetItemCode() uses, so the code is the only thing
+    //            sales need to recompute
+    DatasetRandom random = DatasetRandomFromRow(params, DATASET_STREAM_INVENTORY, row_index ^ (1ull << 63));
+
+    int corruption = DATASET_CORRUPTION_MAX;
+    if(DatasetRandomChance(&random, params->corrupt_rate)){
+        corruption = DatasetRandomBelow(&random, DATASET_CORRUPTION_MAX);
+    }
+
+    memcpy(at, code, 8);
+    at += 8;
+    if(DATASET_CORRUPTION_LONG_CODE == corruption){
+        *at = '0' + DatasetRandomBelow(&random, 10);
+        at += 1;
+    }
+
+    at = DatasetWriteLiteral(at, ", ");
+    if(DATASET_CORRUPTION_LONG_NAME == corruption){
+        char *name_start = at;
+        while(at - name_start < INVENTORY_MAX_NAME_SIZE){
+            at = DatasetWriteName(at, &random);
+            *at = ' ';
+            at += 1;
+        }
+    }else{
+        at = DatasetWriteName(at, &random);
+    }
+
+    // NOTE(tbt): prices are spread evenly over orders of magnitude, from 0.05 to 499.99
+    Money unit_price = 5;
+    for(uint64_t decades_count = DatasetRandomBelow(&random, 4);
+        decades_count > 0;
+        decades_count -= 1){
+        unit_price *= 10;
+    }
+    unit_price += DatasetRandomBelow(&random, unit_price*9);
+    at = DatasetWriteLiteral(at, ", ");
+    char price[MONEY_STRING_SIZE];
+    char *price_end = price + sizeof(price);
+    char *price_start = FormatMoney(price_end, unit_price);
+    memcpy(at, price_start, price_end - price_start);
+    at += price_end - price_start;
+    if(DATASET_CORRUPTION_PRICE == corruption){
+        at = DatasetWriteLiteral(at, "p");
+    }
+
+    uint64_t target_stock = 10 + DatasetRandomBelow(&random, 500);
+    uint64_t restock_level = target_stock / (2 + DatasetRandomBelow(&random, 6));
+    at = DatasetWriteLiteral(at, ", ");
+    if(DATASET_CORRUPTION_QTY == corruption){
+        at = DatasetWriteLiteral(at, "lots");
+    }else{
+        at = DatasetWriteInteger(at, DatasetRandomBelow(&random, target_stock + 1));
+    }
+    at = DatasetWriteLiteral(at, ", ");
+    at = DatasetWriteInteger(at, restock_level);
+    at = DatasetWriteLiteral(at, ", ");
+    at = DatasetWriteInteger(at, target_stock);
+    if(DATASET_CORRUPTION_EXTRA_FIELD == corruption){
+        at = DatasetWriteLiteral(at, ", extra");
+    }
+    at = DatasetWriteLiteral(at, ",\n");
+
+    return at;
+}
+
+static char *
+DatasetWriteSaleRow(DatasetParams *params,
+                    uint64_t row_index,
+                    char *at){
+    DatasetRandom random = DatasetRandomFromRow(params, DATASET_STREAM_SALES, row_index);
+
+    char code[9];
+    if(0 == params->items_count || DatasetRandomChance(&random, params->unknown_sale_rate)){
+        DatasetCodeFromPrefix(DatasetRandomBelow(&random, GTIN8_PREFIX_MAX), code);
+    }else{
+        // NOTE(tbt): cubing a uniform number skews sales towards the first items - the 10% most popular
+        //            make up almost half of them
+        double popularity = DatasetRandomUnit(&random);
+        uint64_t item_index = (uint64_t)(popularity*popularity*popularity*params->items_count);
+        DatasetItemCode(params, item_index, code);
+        if(DatasetRandomChance(&random, params->invalid_code_rate)){
+            DatasetCodeBreakCheckDigit(code, &random);
+        }
+    }
+
+    uint64_t qty = 1;
+    if(DatasetRandomChance(&random, 0.3)){
+        qty += 1 + DatasetRandomBelow(&random, 10);
+    }
+
+    memcpy(at, code, 8);
+    at += 8;
+    at = DatasetWriteLiteral(at, ", ");
+    at = DatasetWriteInteger(at, qty);
+    at = DatasetWriteLiteral(at, "\n");
+
+    return at;
+}
+
+////////////////////////////////
+//~NOTE(tbt): writing datasets
+
+static void
+DatasetThreadProc(void *param){
+    DatasetJob *job = param;
+    char *at = job->buffer;
+    for(uint64_t row_index = job->first_row;
+        row_index < job->first_row + job->rows_count;
+        row_index += 1){
+        at = job->row_function(job->params, row_index, at);
+    }
+    job->used = at - job->buffer;
+}
+
+// NOTE(tbt): rows are formatted a chunk per thread at a time, and the chunks written out in order between
+//            rounds
+static bool
+DatasetWriteRows(DatasetParams *params,
+                 DatasetRowFunction *row_function,
+                 uint64_t rows_count,
+                 char *path){
+    enum{ BUFFER_SIZE = DATASET_ROWS_PER_CHUNK*DATASET_MAX_ROW_SIZE, };
+
+    bool is_success = false;
+
+    int threads_count = PlatformGetProcessorCount();
+    if(threads_count > DATASET_MAX_THREADS){
+        threads_count = DATASET_MAX_THREADS;
+    }
+
+    DatasetJob jobs[DATASET_MAX_THREADS] = {0};
+    bool is_allocated = true;
+    for(int job_index = 0;
+        job_index < threads_count;
+        job_index += 1){
+        jobs[job_index].params = params;
+        jobs[job_index].row_function = row_function;
+        jobs[job_index].buffer = PlatformMemoryAllocate(BUFFER_SIZE);
+        is_allocated = is_allocated && NULL != jobs[job_index].buffer;
+    }
+
+    PlatformFile file = FileFromCommandLinePath(path, true);
+    if(PLATFORM_FILE_INVALID != file && is_allocated){
+        is_success = true;
+        uint64_t next_row = 0;
+        while(is_success && next_row < rows_count){
+            int jobs_count = 0;
+            for(int job_index = 0;
+                job_index < threads_count && next_row < rows_count;
+                job_index += 1){
+                jobs[job_index].first_row = next_row;
+                jobs[job_index].rows_count = (rows_count - next_row > DATASET_ROWS_PER_CHUNK) ? DATASET_ROWS_PER_CHUNK : rows_count - next_row;
+                next_row += jobs[job_index].rows_count;
+                jobs_count += 1;
+            }
+
+            // NOTE(tbt): the calling thread takes the first chunk itself
+            PlatformThread threads[DATASET_MAX_THREADS];
+            bool is_thread_started[DATASET_MAX_THREADS];
+            for(int job_index = 1;
+                job_index < jobs_count;
+                job_index += 1){
+                is_thread_started[job_index] = PlatformThreadCreate(&threads[job_index], DatasetThreadProc, &jobs[job_index]);
+                if(!is_thread_started[job_index]){
+                    DatasetThreadProc(&jobs[job_index]);
+                }
+            }
+            DatasetThreadProc(&jobs[0]);
+            for(int job_index = 1;
+                job_index < jobs_count;
+                job_index += 1){
+                if(is_thread_started[job_index]){
+                    PlatformThreadJoin(threads[job_index]);
+                }
+            }
+
+            for(int job_index = 0;
+                job_index < jobs_count && is_success;
+                job_index += 1){
+                is_success = PlatformFileWrite(file, jobs[job_index].buffer, jobs[job_index].used);
+            }
+        }
+    }
+
+    if(PLATFORM_FILE_INVALID != file && 0 != strcmp(path, "-")){
+        PlatformFileClose(file);
+    }
+    for(int job_index = 0;
+        job_index < threads_count;
+        job_index += 1){
+        if(NULL != jobs[job_index].buffer){
+            PlatformMemoryRelease(jobs[job_index].buffer, BUFFER_SIZE);
+        }
+    }
+
+    return is_success;
+}
+
+static bool
+DatasetGenerateInventory(DatasetParams *params,
+                         char *path){
+    return DatasetWriteRows(params, DatasetWriteInventoryRow, params->items_count, path);
+}
+
+static bool
+DatasetGenerateSales(DatasetParams *params,
+                     char *path){
+    return DatasetWriteRows(params, DatasetWriteSaleRow, params->sales_count, path);
+}
+
+////////////////////////////////
+//~NOTE(tbt): command line
+
+// NOTE(tbt): gtin8_utils --dataset <items> <inventory csv> [--sales <count> <sales csv>] [--seed <n>]
+//                        [--duplicates <rate>] [--corrupt <rate>] [--invalid <rate>] [--unknown <rate>]
+//
+//            rates are fractions between 0 and 1. - writes to stdout. returns true if the command line asked
+//            for a dataset, in which case it has already been written
+static bool
+DatasetRunCommandLine(int argc,
+                      char **argv,
+                      int *exit_code){
+    bool is_dataset = false;
+    *exit_code = 0;
+
+    if(argc >= 4 && 0 == strcmp(argv[1], "--dataset")){
+        is_dataset = true;
+
+        DatasetParams params = {
+            .seed = 1,
+            .items_count = strtoull(argv[2], NULL, 10),
+        };
+        char *inventory_path = argv[3];
+        char *sales_path = NULL;
+
+        int arg_index = 4;
+        for(;
+            arg_index + 1 < argc;
+            arg_index += 2){
+            char *arg = argv[arg_index];
+            char *value = argv[arg_index + 1];
+            if(0 == strcmp(arg, "--sales") && arg_index + 2 < argc){
+                params.sales_count = strtoull(value, NULL, 10);
+                sales_path = argv[arg_index + 2];
+                arg_index += 1;
+            }else if(0 == strcmp(arg, "--seed")){
+                params.seed = strtoull(value, NULL, 10);
+            }else if(0 == strcmp(arg, "--duplicates")){
+                params.duplicate_rate = strtod(value, NULL);
+            }else if(0 == strcmp(arg, "--corrupt")){
+                params.corrupt_rate = strtod(value, NULL);
+            }else if(0 == strcmp(arg, "--invalid")){
+                params.invalid_code_rate = strtod(value, NULL);
+            }else if(0 == strcmp(arg, "--unknown")){
+                params.unknown_sale_rate = strtod(value, NULL);
+            }else{
+                *exit_code = 1;
+            }
+        }
+        if(arg_index < argc){
+            // NOTE(tbt): an option without a value
+            *exit_code = 1;
+        }
+
+        if(0 == *exit_code && !DatasetGenerateInventory(&params, inventory_path)){
+            *exit_code = 1;
+        }
+        if(0 == *exit_code && NULL != sales_path && !DatasetGenerateSales(&params, sales_path)){
+            *exit_code = 1;
+        }
+    }
+
+    return is_dataset;
+}
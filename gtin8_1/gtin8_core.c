@@ -0,0 +1,2399 @@
+////////////////////////////////
+//~NOTE(tbt): GTIN-8 core
+
+// NOTE(tbt): GTIN-8 maths, the inventory and receipts, and the headless command line. nothing in here knows
+//            about windows or the UI - it only talks to the OS through platform.h
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    DUMMY_INVENTORY_ITEM_ITEM_NOT_FOUND = 0,
+    DUMMY_INVENTORY_ITEM_INVALID_CODE = 1,
+    
+    DUMMY_INVENTORY_ITEM_MAX,
+};
+
+enum{
+    INVENTORY_MAX_NAME_SIZE = 512, // NOTE(tbt): including the null terminator - longer names are a parse error
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef enum ReceiptItemError{
+    RECEIPT_ITEM_ERROR_NONE,
+    RECEIPT_ITEM_ERROR_PARSE_ERROR,
+    RECEIPT_ITEM_ERROR_ITEM_NOT_FOUND,
+    RECEIPT_ITEM_ERROR_INVALID_GTIN8_CODE
+} ReceiptItemError;
+
+// NOTE(tbt): an exact amount of money in minor units (hundredths of a pound/dollar)
+typedef int64_t Money;
+
+// NOTE(tbt): a GTIN-8 code as it appeared in the inventory file - up to 8 characters, padded with null bytes
+//            but not null terminated
+typedef struct GTIN8Code{
+    char digits[8];
+}GTIN8Code;
+
+// NOTE(tbt): a line of the inventory file as it is parsed, before being split up in to the inventory's columns
+typedef struct InventoryRecord{
+    ReceiptItemError error;
+    GTIN8Code code;
+    size_t name_offset; // NOTE(tbt): offset of the null terminated name in the buffer the file was parsed in
+    Money unit_price;
+    int qty;
+    int restock_level;
+    int target_stock;
+}InventoryRecord;
+
+// NOTE(tbt): a linear allocator over a large reservation of address space, committed in geometrically
+//            growing chunks as it fills up
+typedef struct Arena{
+    char *base;
+    size_t reserved;
+    size_t committed;
+    size_t used;
+}Arena;
+
+// NOTE(tbt): slot in the open addressing hash index from GTIN-8 codes to items. codes are packed as
+//            their numeric value. item_index is 0 for empty slots, as index 0 is always a dummy item
+typedef struct InventoryIndexSlot{
+    uint32_t code;
+    uint32_t item_index;
+}InventoryIndexSlot;
+
+// NOTE(tbt): the inventory is stored as parallel columns, one entry per item, so that a scan over a couple
+//            of fields (e.g. comparing stock to restock levels) only touches the memory for those fields.
+//            items are referred to by their index in the columns, the first DUMMY_INVENTORY_ITEM_MAX of
+//            which are dummy items representing lookup errors
+typedef struct Inventory{
+    size_t items_count;
+    uint8_t *errors; // NOTE(tbt): ReceiptItemError
+    GTIN8Code *codes;
+    uint32_t *name_offsets;
+    Money *unit_prices;
+    int32_t *qtys;
+    int32_t *restock_levels;
+    int32_t *target_stocks;
+    Arena columns_arena;
+    
+    // NOTE(tbt): pool of null terminated names, each stored once no matter how many items share it.
+    //            offset 0 is always an empty string
+    char *strings;
+    size_t strings_size;
+    Arena strings_arena;
+    
+    InventoryIndexSlot *index_slots;
+    size_t index_capacity; // NOTE(tbt): always a power of 2
+    size_t index_count;
+    
+    // NOTE(tbt): non-NULL for an inventory mapped from a snapshot, in which case the columns, strings and
+    //            index all point in to the view
+    void *snapshot_view;
+    uint64_t snapshot_view_size;
+    
+    // NOTE(tbt): a compaction of the inventory's journal running in the background, if there is one
+    PlatformThread compaction_thread;
+    struct InventoryCompaction *compaction;
+}Inventory;
+
+// NOTE(tbt): a line of a receipt refers to the inventory item it is for by index
+typedef struct ReceiptLine{
+    uint32_t item_index;
+    int qty;
+}ReceiptLine;
+
+typedef struct Receipt{
+    Arena lines_arena;
+    ReceiptLine *lines;
+    size_t lines_count;
+}Receipt;
+
+typedef enum GTIN8VerifyResult{
+    VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING = -1,
+    VERIFY_GTIN8_RESULT_FAILURE,
+    VERIFY_GTIN8_RESULT_SUCCESS,
+}GTIN8VerifyResult;
+
+// NOTE(tbt): accumulates writes to a file to avoid a syscall for every small write
+typedef struct OutputBuffer{
+    PlatformFile file;
+    char *buffer;
+    size_t size;
+    size_t used;
+    bool is_error; // NOTE(tbt): set if any write to the file has failed
+}OutputBuffer;
+
+////////////////////////////////
+//~NOTE(tbt): GTIN-8 codes
+
+static void
+GTIN8FromFirst7Digits(char result[9],
+                      char input[8]){
+    if(7 == strlen(input)){
+        memcpy(result, input, 8);
+        int sum = 0;
+        bool is_error = false;
+        for(int i = 0;
+            i < 7 && !is_error;
+            i += 1){
+            if(isdigit(result[i])){
+                int digit = result[i] - '0';
+                if(0 == i % 2){
+                    digit *= 3;
+                }
+                sum += digit;
+            }else{
+                strncpy(result, "error", 7);
+                is_error = true;
+            }
+        }
+        if(!is_error){
+            int next_multiple_of_ten = sum + (10 - (sum % 10));
+            if(0 == sum % 10){
+                next_multiple_of_ten = sum;
+            }
+            int check_digit = next_multiple_of_ten - sum;
+            result[7] = check_digit + '0';
+            result[8] = '\0';
+        }
+    }else{
+        strncpy(result, "error", 7);
+    }
+}
+
+static GTIN8VerifyResult
+GTIN8Verify(char input[9]){
+    GTIN8VerifyResult result = VERIFY_GTIN8_RESULT_SUCCESS;
+    if(8 == strlen(input)){
+        int sum = 0;
+        for(int i = 0;
+            i < 7 && VERIFY_GTIN8_RESULT_SUCCESS == result;
+            i += 1){
+            if(isdigit(input[i])){
+                int digit = input[i] - '0';
+                if(0 == i % 2){
+                    digit *= 3;
+                }
+                sum += digit;
+            }else{
+                result = VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING;
+            }
+        }
+        if(VERIFY_GTIN8_RESULT_SUCCESS == result){
+            int next_multiple_of_ten = sum + (10 - (sum % 10));
+            if(0 == sum % 10){
+                next_multiple_of_ten = sum;
+            }
+            int check_digit = next_multiple_of_ten - sum;
+            if(input[7] - '0' != check_digit){
+                result = VERIFY_GTIN8_RESULT_FAILURE;
+            }
+        }
+    }else{
+        result = VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING;
+    }
+    return result;
+}
+
+////////////////////////////////
+//~NOTE(tbt): batch GTIN-8 verification
+
+// NOTE(tbt): weighting the check digit by 1 alongside the 3-1-3-1-3-1-3 weights of the first 7 digits means a
+//            code is valid iff the weighted sum of all 8 digits is a multiple of 10. the weighted sum is
+//            computed as sum(all digits) + 2*sum(even digits) which maps nicely on to PSADBW, as each
+//            8 byte code lines up exactly with one of its 64 bit lanes.
+//
+//            results are written as int8_t holding a GTIN8VerifyResult. a code is only considered well
+//            formed if all 8 characters (including the check digit) are digits.
+
+static GTIN8VerifyResult
+GTIN8VerifyCode(const char code[8]){
+    int sum = 0;
+    bool is_digits = true;
+    for(int i = 0;
+        i < 8;
+        i += 1){
+        unsigned int digit = (unsigned char)code[i] - '0';
+        if(digit > 9){
+            is_digits = false;
+        }
+        sum += (0 == i % 2) ? digit*3 : digit;
+    }
+    GTIN8VerifyResult result = VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING;
+    if(is_digits){
+        result = (0 == sum % 10) ? VERIFY_GTIN8_RESULT_SUCCESS : VERIFY_GTIN8_RESULT_FAILURE;
+    }
+    return result;
+}
+
+static void
+GTIN8VerifyBatchScalar(const char *codes,
+                       size_t codes_count,
+                       int8_t *results){
+    for(size_t i = 0;
+        i < codes_count;
+        i += 1){
+        results[i] = GTIN8VerifyCode(&codes[i*8]);
+    }
+}
+
+#if ARCH_X86
+
+// NOTE(tbt): lookup from (is_digits | is_multiple_of_ten << 1) to the verify result
+static const int8_t g_gtin8_verify_result_from_flags[4] = {
+    VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING,
+    VERIFY_GTIN8_RESULT_FAILURE,
+    VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING,
+    VERIFY_GTIN8_RESULT_SUCCESS,
+};
+
+static void
+GTIN8VerifyBatchSSE2(const char *codes,
+                     size_t codes_count,
+                     int8_t *results){
+    const __m128i ascii_zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i even_digits = _mm_set1_epi64x(0x00ff00ff00ff00ffll);
+    const __m128i div_10_magic = _mm_set1_epi16(205); // NOTE(tbt): (x*205) >> 11 == x/10 for the range of possible sums
+    const __m128i ten = _mm_set1_epi16(10);
+    
+    size_t i = 0;
+    for(;
+        i + 2 <= codes_count;
+        i += 2){
+        __m128i digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)&codes[i*8]), ascii_zero);
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits);
+        
+        // NOTE(tbt): sum ends up in the low 16 bits of each 64 bit lane, with the upper bits zeroed
+        __m128i sum = _mm_add_epi64(_mm_sad_epu8(digits, zero),
+                                    _mm_slli_epi64(_mm_sad_epu8(_mm_and_si128(digits, even_digits), zero), 1));
+        __m128i quotient = _mm_srli_epi16(_mm_mullo_epi16(sum, div_10_magic), 11);
+        __m128i remainder = _mm_sub_epi16(sum, _mm_mullo_epi16(quotient, ten));
+        
+        unsigned int digit_mask = _mm_movemask_epi8(is_digit);
+        unsigned int check_mask = _mm_movemask_epi8(_mm_cmpeq_epi16(remainder, zero));
+        for(int j = 0;
+            j < 2;
+            j += 1){
+            int is_digits = (0xff == ((digit_mask >> (j*8)) & 0xff));
+            int is_multiple_of_ten = (check_mask >> (j*8)) & 1;
+            results[i + j] = g_gtin8_verify_result_from_flags[is_digits | (is_multiple_of_ten << 1)];
+        }
+    }
+    GTIN8VerifyBatchScalar(&codes[i*8], codes_count - i, &results[i]);
+}
+
+TARGET_AVX2 static void
+GTIN8VerifyBatchAVX2(const char *codes,
+                     size_t codes_count,
+                     int8_t *results){
+    const __m256i ascii_zero = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i even_digits = _mm256_set1_epi64x(0x00ff00ff00ff00ffll);
+    const __m256i div_10_magic = _mm256_set1_epi16(205);
+    const __m256i ten = _mm256_set1_epi16(10);
+    
+    size_t i = 0;
+    for(;
+        i + 4 <= codes_count;
+        i += 4){
+        __m256i digits = _mm256_sub_epi8(_mm256_loadu_si256((const __m256i *)&codes[i*8]), ascii_zero);
+        __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, nine), digits);
+        
+        __m256i sum = _mm256_add_epi64(_mm256_sad_epu8(digits, zero),
+                                       _mm256_slli_epi64(_mm256_sad_epu8(_mm256_and_si256(digits, even_digits), zero), 1));
+        __m256i quotient = _mm256_srli_epi16(_mm256_mullo_epi16(sum, div_10_magic), 11);
+        __m256i remainder = _mm256_sub_epi16(sum, _mm256_mullo_epi16(quotient, ten));
+        
+        unsigned int digit_mask = _mm256_movemask_epi8(is_digit);
+        unsigned int check_mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(remainder, zero));
+        for(int j = 0;
+            j < 4;
+            j += 1){
+            int is_digits = (0xff == ((digit_mask >> (j*8)) & 0xff));
+            int is_multiple_of_ten = (check_mask >> (j*8)) & 1;
+            results[i + j] = g_gtin8_verify_result_from_flags[is_digits | (is_multiple_of_ten << 1)];
+        }
+    }
+    GTIN8VerifyBatchSSE2(&codes[i*8], codes_count - i, &results[i]);
+}
+
+static bool
+IsAVX2Supported(void){
+# if defined(_MSC_VER)
+    bool result = false;
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] >= 7){
+        __cpuid(info, 1);
+        bool is_os_saving_ymm = false;
+        if(info[2] & (1 << 27)){ // NOTE(tbt): OSXSAVE
+            is_os_saving_ymm = (6 == (_xgetbv(0) & 6));
+        }
+        __cpuidex(info, 7, 0);
+        result = is_os_saving_ymm && (info[1] & (1 << 5));
+    }
+    return result;
+# else
+    return __builtin_cpu_supports("avx2");
+# endif
+}
+
+#endif
+
+// NOTE(tbt): verify codes_count codes packed back to back, 8 bytes each, with no separators or terminators
+static void
+GTIN8VerifyBatch(const char *codes,
+                 size_t codes_count,
+                 int8_t *results){
+    typedef void GTIN8VerifyBatchFunction(const char *, size_t, int8_t *);
+    static GTIN8VerifyBatchFunction *kernel = NULL;
+    if(NULL == kernel){
+#if ARCH_X86
+        kernel = IsAVX2Supported() ? GTIN8VerifyBatchAVX2 : GTIN8VerifyBatchSSE2;
+#else
+        kernel = GTIN8VerifyBatchScalar;
+#endif
+    }
+    kernel(codes, codes_count, results);
+}
+
+// NOTE(tbt): verify each line of newline separated text. a line which is not exactly 8 characters long
+//            (ignoring a trailing '\r') is reported as malformed. a final line without a trailing newline
+//            is still counted. returns the number of lines, writing at most max_results results
+static size_t
+GTIN8VerifyText(const char *text,
+                size_t text_size,
+                int8_t *results,
+                size_t max_results){
+    enum{ BATCH_SIZE = 1024, };
+    char batch[BATCH_SIZE*8];
+    size_t batch_count = 0;
+    size_t lines_count = 0;
+    
+    const char *text_end = text + text_size;
+    const char *line = text;
+    while(line < text_end && lines_count < max_results){
+        const char *line_end = memchr(line, '\n', text_end - line);
+        if(NULL == line_end){
+            line_end = text_end;
+        }
+        size_t line_length = line_end - line;
+        if(line_length > 0 && '\r' == line[line_length - 1]){
+            line_length -= 1;
+        }
+        
+        // NOTE(tbt): anything which is the wrong length gets replaced with a code which can never be well formed
+        if(8 == line_length){
+            memcpy(&batch[batch_count*8], line, 8);
+        }else{
+            memset(&batch[batch_count*8], 0xff, 8);
+        }
+        batch_count += 1;
+        lines_count += 1;
+        
+        if(BATCH_SIZE == batch_count){
+            GTIN8VerifyBatch(batch, batch_count, &results[lines_count - batch_count]);
+            batch_count = 0;
+        }
+        
+        line = line_end + 1;
+    }
+    GTIN8VerifyBatch(batch, batch_count, &results[lines_count - batch_count]);
+    
+    return lines_count;
+}
+
+////////////////////////////////
+//~NOTE(tbt): buffered output
+
+static void
+OutputBufferFlush(OutputBuffer *output){
+    if(!PlatformFileWrite(output->file, output->buffer, output->used)){
+        output->is_error = true;
+    }
+    output->used = 0;
+}
+
+static void
+OutputBufferWrite(OutputBuffer *output,
+                  const void *data,
+                  size_t size){
+    if(output->used + size > output->size){
+        OutputBufferFlush(output);
+    }
+    if(size > output->size){
+        // NOTE(tbt): too big to ever fit in the buffer, so just write it straight through
+        if(!PlatformFileWrite(output->file, data, size)){
+            output->is_error = true;
+        }
+    }else{
+        memcpy(output->buffer + output->used, data, size);
+        output->used += size;
+    }
+}
+
+#define OutputBufferWriteLiteral(O, S) OutputBufferWrite((O), (S), sizeof(S) - 1)
+
+static void
+OutputBufferWriteString(OutputBuffer *output,
+                        const char *string){
+    OutputBufferWrite(output, string, strlen(string));
+}
+
+static const char g_decimal_digit_pairs[] =
+"00010203040506070809"
+"10111213141516171819"
+"20212223242526272829"
+"30313233343536373839"
+"40414243444546474849"
+"50515253545556575859"
+"60616263646566676869"
+"70717273747576777879"
+"80818283848586878889"
+"90919293949596979899";
+
+// NOTE(tbt): format value in decimal so that it ends at end, two digits at a time. returns where it starts -
+//            there must be room for up to 20 digits before end
+static char *
+FormatUnsignedDecimal(char *end,
+                      uint64_t value){
+    char *at = end;
+    while(value >= 100){
+        at -= 2;
+        memcpy(at, &g_decimal_digit_pairs[(value % 100)*2], 2);
+        value /= 100;
+    }
+    if(value >= 10){
+        at -= 2;
+        memcpy(at, &g_decimal_digit_pairs[value*2], 2);
+    }else{
+        at -= 1;
+        *at = '0' + value;
+    }
+    return at;
+}
+
+static void
+OutputBufferWriteInteger(OutputBuffer *output,
+                         int64_t value){
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *at = FormatUnsignedDecimal(end, (value < 0) ? -(uint64_t)value : (uint64_t)value);
+    if(value < 0){
+        at -= 1;
+        *at = '-';
+    }
+    OutputBufferWrite(output, at, end - at);
+}
+
+enum{
+    MONEY_STRING_SIZE = 32,
+};
+
+// NOTE(tbt): format value as a whole number of major units and 2 decimal places, ending at end. returns where
+//            it starts - there must be room for MONEY_STRING_SIZE - 1 characters before end
+static char *
+FormatMoney(char *end,
+            Money value){
+    uint64_t magnitude = (value < 0) ? -(uint64_t)value : (uint64_t)value;
+    char *at = end - 2;
+    memcpy(at, &g_decimal_digit_pairs[(magnitude % 100)*2], 2);
+    at -= 1;
+    *at = '.';
+    at = FormatUnsignedDecimal(at, magnitude / 100);
+    if(value < 0){
+        at -= 1;
+        *at = '-';
+    }
+    return at;
+}
+
+// NOTE(tbt): returns a null terminated string somewhere in buffer
+static char *
+StringFromMoney(char buffer[MONEY_STRING_SIZE],
+                Money value){
+    buffer[MONEY_STRING_SIZE - 1] = '\0';
+    return FormatMoney(&buffer[MONEY_STRING_SIZE - 1], value);
+}
+
+static void
+OutputBufferWriteMoney(OutputBuffer *output,
+                       Money value){
+    char buffer[MONEY_STRING_SIZE];
+    char *end = buffer + sizeof(buffer);
+    char *at = FormatMoney(end, value);
+    OutputBufferWrite(output, at, end - at);
+}
+
+////////////////////////////////
+//~NOTE(tbt): headless verification
+
+// NOTE(tbt): stream newline separated codes from input, writing each line back out to output followed by its
+//            result, e.g. "34512340, valid". a line too long to fit in the input buffer can't be a code, so it
+//            is written out as just ", malformed" - there is always one line of output per line of input
+static void
+GTIN8VerifyStream(PlatformFile input,
+                  PlatformFile output_file){
+    enum{
+        INPUT_BUFFER_SIZE = 1 << 20,
+        OUTPUT_BUFFER_SIZE = 1 << 22,
+    };
+    
+    char *input_buffer = PlatformMemoryAllocate(INPUT_BUFFER_SIZE);
+    int8_t *results = PlatformMemoryAllocate(INPUT_BUFFER_SIZE + 1);
+    OutputBuffer output = {
+        .file = output_file,
+        .buffer = PlatformMemoryAllocate(OUTPUT_BUFFER_SIZE),
+        .size = OUTPUT_BUFFER_SIZE,
+    };
+    
+    static const struct{ const char *string; size_t length; } result_strings[] = {
+        [1 + VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING] = { ", malformed\n", 12 },
+        [1 + VERIFY_GTIN8_RESULT_FAILURE]              = { ", invalid\n",   10 },
+        [1 + VERIFY_GTIN8_RESULT_SUCCESS]              = { ", valid\n",      8 },
+    };
+    
+    if(NULL != input_buffer && NULL != results && NULL != output.buffer){
+        size_t carried_bytes = 0;
+        bool is_eof = false;
+        bool is_skipping_line = false; // NOTE(tbt): in the rest of a line which didn't fit, and has been reported
+        while(!is_eof){
+            size_t n_bytes_read = 0;
+            if(!PlatformFileRead(input, input_buffer + carried_bytes, INPUT_BUFFER_SIZE - carried_bytes, &n_bytes_read) ||
+               0 == n_bytes_read){
+                is_eof = true;
+            }
+            size_t bytes_available = carried_bytes + n_bytes_read;
+            
+            if(is_skipping_line){
+                const char *newline = memchr(input_buffer, '\n', bytes_available);
+                size_t bytes_skipped = bytes_available;
+                if(NULL != newline){
+                    bytes_skipped = newline + 1 - input_buffer;
+                    is_skipping_line = false;
+                }
+                bytes_available -= bytes_skipped;
+                memmove(input_buffer, input_buffer + bytes_skipped, bytes_available);
+            }
+            
+            // NOTE(tbt): only process complete lines, unless this is the end of the input
+            size_t bytes_to_process = bytes_available;
+            if(!is_eof){
+                while(bytes_to_process > 0 && '\n' != input_buffer[bytes_to_process - 1]){
+                    bytes_to_process -= 1;
+                }
+                if(0 == bytes_to_process && INPUT_BUFFER_SIZE == bytes_available){
+                    // NOTE(tbt): a single line fills the entire buffer
+                    OutputBufferWrite(&output,
+                                      result_strings[1 + VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING].string,
+                                      result_strings[1 + VERIFY_GTIN8_RESULT_INVALID_INPUT_STRING].length);
+                    is_skipping_line = true;
+                    bytes_available = 0;
+                }
+            }
+            
+            size_t lines_count = GTIN8VerifyText(input_buffer, bytes_to_process, results, INPUT_BUFFER_SIZE + 1);
+            
+            const char *line = input_buffer;
+            const char *text_end = input_buffer + bytes_to_process;
+            for(size_t i = 0;
+                i < lines_count;
+                i += 1){
+                const char *line_end = memchr(line, '\n', text_end - line);
+                if(NULL == line_end){
+                    line_end = text_end;
+                }
+                size_t line_length = line_end - line;
+                if(line_length > 0 && '\r' == line[line_length - 1]){
+                    line_length -= 1;
+                }
+                OutputBufferWrite(&output, line, line_length);
+                OutputBufferWrite(&output, result_strings[1 + results[i]].string, result_strings[1 + results[i]].length);
+                line = line_end + 1;
+            }
+            
+            carried_bytes = bytes_available - bytes_to_process;
+            memmove(input_buffer, input_buffer + bytes_to_process, carried_bytes);
+        }
+        OutputBufferFlush(&output);
+    }
+    
+    if(NULL != input_buffer){ PlatformMemoryRelease(input_buffer, INPUT_BUFFER_SIZE); }
+    if(NULL != results){ PlatformMemoryRelease(results, INPUT_BUFFER_SIZE + 1); }
+    if(NULL != output.buffer){ PlatformMemoryRelease(output.buffer, OUTPUT_BUFFER_SIZE); }
+}
+
+////////////////////////////////
+//~NOTE(tbt): GTIN-8 range generation
+
+// NOTE(tbt): every code for a range of 7 digit prefixes. rather than formatting and re-parsing each
+//            prefix, the digits and their weighted sum are kept in an odometer which is stepped forward
+//            one prefix at a time, so generating each code is a couple of adds and a table lookup.
+//
+//            the output is fixed width, so a range can be split between threads with each writing
+//            straight to its own slice of the output buffer.
+
+enum{
+    GTIN8_PREFIX_MAX = 10000000,
+    GTIN8_MAX_WEIGHTED_SUM = 4*3*9 + 3*9, // NOTE(tbt): the largest possible weighted sum of 7 digits
+};
+
+typedef enum GTIN8GenerateFormat{
+    GTIN8_GENERATE_FORMAT_TEXT,   // NOTE(tbt): 8 ASCII digits followed by '\n' per code
+    GTIN8_GENERATE_FORMAT_BINARY, // NOTE(tbt): little endian uint32_t holding the numeric value of each code
+}GTIN8GenerateFormat;
+
+static const int g_gtin8_digit_weights[7] = { 3, 1, 3, 1, 3, 1, 3 };
+
+// NOTE(tbt): the ASCII check digit for each possible weighted sum, (10 - sum % 10) % 10
+static const char g_gtin8_check_digit_from_sum[] =
+"0987654321" "0987654321" "0987654321" "0987654321" "0987654321" "0987654321" "0987654321"
+"0987654321" "0987654321" "0987654321" "0987654321" "0987654321" "0987654321" "0987654321";
+
+static size_t
+GTIN8GenerateRecordSize(GTIN8GenerateFormat format){
+    return (GTIN8_GENERATE_FORMAT_TEXT == format) ? 9 : sizeof(uint32_t);
+}
+
+static void
+GTIN8GenerateRange(uint32_t start,
+                   uint32_t end,
+                   GTIN8GenerateFormat format,
+                   char *output){
+    char line[9];
+    int sum = 0;
+    {
+        uint32_t prefix = start;
+        for(int i = 6;
+            i >= 0;
+            i -= 1){
+            int digit = prefix % 10;
+            line[i] = '0' + digit;
+            sum += digit*g_gtin8_digit_weights[i];
+            prefix /= 10;
+        }
+        line[8] = '\n';
+    }
+    
+    uint32_t code = start*10;
+    for(uint32_t prefix = start;
+        prefix < end;
+        prefix += 1){
+        if(GTIN8_GENERATE_FORMAT_TEXT == format){
+            line[7] = g_gtin8_check_digit_from_sum[sum];
+            memcpy(output, line, sizeof(line));
+            output += sizeof(line);
+        }else{
+            uint32_t value = code + (g_gtin8_check_digit_from_sum[sum] - '0');
+            memcpy(output, &value, sizeof(value));
+            output += sizeof(value);
+        }
+        code += 10;
+        
+        // NOTE(tbt): step the odometer
+        int i = 6;
+        line[i] += 1;
+        sum += g_gtin8_digit_weights[i];
+        while(line[i] > '9' && i > 0){
+            line[i] = '0';
+            sum -= 10*g_gtin8_digit_weights[i];
+            i -= 1;
+            line[i] += 1;
+            sum += g_gtin8_digit_weights[i];
+        }
+    }
+}
+
+typedef struct GTIN8GenerateJob{
+    uint32_t start;
+    uint32_t end;
+    GTIN8GenerateFormat format;
+    char *output;
+}GTIN8GenerateJob;
+
+static void
+GTIN8GenerateThreadProc(void *param){
+    GTIN8GenerateJob *job = param;
+    GTIN8GenerateRange(job->start, job->end, job->format, job->output);
+}
+
+// NOTE(tbt): write every code with a prefix in [start, end) to output_file. the range is generated a block
+//            at a time, with each block partitioned between one thread per core
+static bool
+GTIN8GenerateRangeToFile(uint32_t start,
+                         uint32_t end,
+                         GTIN8GenerateFormat format,
+                         PlatformFile output_file){
+    enum{
+        BLOCK_SIZE = 1 << 22,
+        MAX_THREADS = 64,
+    };
+    
+    bool is_success = false;
+    
+    if(start <= end && end <= GTIN8_PREFIX_MAX){
+        size_t record_size = GTIN8GenerateRecordSize(format);
+        
+        OutputBuffer output = {
+            .file = output_file,
+            .buffer = PlatformMemoryAllocate(BLOCK_SIZE*record_size),
+            .size = BLOCK_SIZE*record_size,
+        };
+        
+        int threads_count;{
+            threads_count = PlatformGetProcessorCount();
+            if(threads_count < 1){
+                threads_count = 1;
+            }else if(threads_count > MAX_THREADS){
+                threads_count = MAX_THREADS;
+            }
+        }
+        
+        if(NULL != output.buffer){
+            is_success = true;
+            for(uint32_t block_start = start;
+                block_start < end;
+                block_start += BLOCK_SIZE){
+                uint32_t block_end = (end - block_start > BLOCK_SIZE) ? block_start + BLOCK_SIZE : end;
+                uint32_t block_count = block_end - block_start;
+                
+                GTIN8GenerateJob jobs[MAX_THREADS];
+                PlatformThread threads[MAX_THREADS];
+                bool is_thread_started[MAX_THREADS];
+                int jobs_count = 0;
+                for(int thread_index = 0;
+                    thread_index < threads_count;
+                    thread_index += 1){
+                    uint32_t job_start = block_start + (uint64_t)block_count*thread_index/threads_count;
+                    uint32_t job_end = block_start + (uint64_t)block_count*(thread_index + 1)/threads_count;
+                    if(job_start < job_end){
+                        jobs[jobs_count] = (GTIN8GenerateJob){
+                            .start = job_start,
+                            .end = job_end,
+                            .format = format,
+                            .output = output.buffer + (job_start - block_start)*record_size,
+                        };
+                        jobs_count += 1;
+                    }
+                }
+                
+                // NOTE(tbt): the calling thread takes the first job itself
+                for(int job_index = 1;
+                    job_index < jobs_count;
+                    job_index += 1){
+                    is_thread_started[job_index] = PlatformThreadCreate(&threads[job_index], GTIN8GenerateThreadProc, &jobs[job_index]);
+                    if(!is_thread_started[job_index]){
+                        GTIN8GenerateThreadProc(&jobs[job_index]);
+                    }
+                }
+                GTIN8GenerateThreadProc(&jobs[0]);
+                for(int job_index = 1;
+                    job_index < jobs_count;
+                    job_index += 1){
+                    if(is_thread_started[job_index]){
+                        PlatformThreadJoin(threads[job_index]);
+                    }
+                }
+                
+                output.used = block_count*record_size;
+                if(!PlatformFileWrite(output.file, output.buffer, output.used)){
+                    is_success = false;
+                    break;
+                }
+                output.used = 0;
+            }
+            PlatformMemoryRelease(output.buffer, output.size);
+        }
+    }
+    
+    return is_success;
+}
+
+////////////////////////////////
+//~NOTE(tbt): memory arenas
+
+enum{
+    ARENA_MIN_COMMIT = 1 << 16,
+};
+
+// NOTE(tbt): reserve lots of address space on 64 bit targets - it costs nothing until it is committed
+#define ARENA_DEFAULT_RESERVE ((sizeof(void *) >= 8) ? ((size_t)1 << 36) : ((size_t)1 << 28))
+
+// NOTE(tbt): push size bytes without clearing them. memory which has never been used is zero, but memory
+//            reused after an ArenaReset() holds whatever was there before. returns NULL if the reservation
+//            is exhausted or the commit fails
+static void *
+ArenaPushNoZero(Arena *arena,
+                size_t size){
+    void *result = NULL;
+    
+    if(NULL == arena->base){
+        arena->base = PlatformMemoryReserve(ARENA_DEFAULT_RESERVE);
+        arena->reserved = (NULL == arena->base) ? 0 : ARENA_DEFAULT_RESERVE;
+    }
+    
+    if(arena->reserved - arena->used >= size){
+        size_t required = arena->used + size;
+        if(required > arena->committed){
+            // NOTE(tbt): at least double what is committed each time, so the number of commits is
+            //            logarithmic in the size of the arena
+            size_t new_committed = (arena->committed < ARENA_MIN_COMMIT) ? ARENA_MIN_COMMIT : arena->committed*2;
+            while(new_committed < required){
+                new_committed *= 2;
+            }
+            if(new_committed > arena->reserved){
+                new_committed = arena->reserved;
+            }
+            if(PlatformMemoryCommit(arena->base + arena->committed, new_committed - arena->committed)){
+                arena->committed = new_committed;
+            }
+        }
+        if(required <= arena->committed){
+            result = arena->base + arena->used;
+            arena->used = required;
+        }
+    }
+    
+    return result;
+}
+
+static void *
+ArenaPush(Arena *arena,
+          size_t size){
+    void *result = ArenaPushNoZero(arena, size);
+    if(NULL != result){
+        memset(result, 0, size);
+    }
+    return result;
+}
+
+// NOTE(tbt): forget everything in the arena, but keep its memory committed for reuse
+static void
+ArenaReset(Arena *arena){
+    arena->used = 0;
+}
+
+static void
+ArenaRelease(Arena *arena){
+    if(NULL != arena->base){
+        PlatformMemoryRelease(arena->base, arena->reserved);
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+////////////////////////////////
+//~NOTE(tbt): receipts
+
+static ReceiptLine *
+ReceiptPushLine(Receipt *receipt){
+    ReceiptLine *result = ArenaPush(&receipt->lines_arena, sizeof(ReceiptLine));
+    if(NULL != result){
+        receipt->lines = (ReceiptLine *)receipt->lines_arena.base;
+        receipt->lines_count += 1;
+    }
+    return result;
+}
+
+// NOTE(tbt): keeps the line memory committed, ready for the next receipt
+static void
+ReceiptClear(Receipt *receipt){
+    ArenaReset(&receipt->lines_arena);
+    receipt->lines = NULL;
+    receipt->lines_count = 0;
+}
+
+////////////////////////////////
+//~NOTE(tbt): inventory
+
+enum{
+    INVENTORY_COLUMN_ERRORS,
+    INVENTORY_COLUMN_CODES,
+    INVENTORY_COLUMN_NAME_OFFSETS,
+    INVENTORY_COLUMN_UNIT_PRICES,
+    INVENTORY_COLUMN_QTYS,
+    INVENTORY_COLUMN_RESTOCK_LEVELS,
+    INVENTORY_COLUMN_TARGET_STOCKS,
+    
+    INVENTORY_COLUMN_MAX
+};
+
+enum{
+    INVENTORY_COLUMN_ALIGNMENT = 64,
+};
+
+typedef struct InventoryColumn{
+    void **data;
+    size_t element_size;
+}InventoryColumn;
+
+// NOTE(tbt): lets the columns be allocated, written out and mapped back in without listing them every time
+static void
+InventoryGetColumns(Inventory *inventory,
+                    InventoryColumn columns[INVENTORY_COLUMN_MAX]){
+    columns[INVENTORY_COLUMN_ERRORS]         = (InventoryColumn){ (void **)&inventory->errors,         sizeof(inventory->errors[0]) };
+    columns[INVENTORY_COLUMN_CODES]          = (InventoryColumn){ (void **)&inventory->codes,          sizeof(inventory->codes[0]) };
+    columns[INVENTORY_COLUMN_NAME_OFFSETS]   = (InventoryColumn){ (void **)&inventory->name_offsets,   sizeof(inventory->name_offsets[0]) };
+    columns[INVENTORY_COLUMN_UNIT_PRICES]    = (InventoryColumn){ (void **)&inventory->unit_prices,    sizeof(inventory->unit_prices[0]) };
+    columns[INVENTORY_COLUMN_QTYS]           = (InventoryColumn){ (void **)&inventory->qtys,           sizeof(inventory->qtys[0]) };
+    columns[INVENTORY_COLUMN_RESTOCK_LEVELS] = (InventoryColumn){ (void **)&inventory->restock_levels, sizeof(inventory->restock_levels[0]) };
+    columns[INVENTORY_COLUMN_TARGET_STOCKS]  = (InventoryColumn){ (void **)&inventory->target_stocks,  sizeof(inventory->target_stocks[0]) };
+}
+
+static size_t
+InventoryColumnSize(InventoryColumn column,
+                    size_t items_count){
+    size_t result = items_count*column.element_size;
+    result = (result + INVENTORY_COLUMN_ALIGNMENT - 1) & ~(size_t)(INVENTORY_COLUMN_ALIGNMENT - 1);
+    return result;
+}
+
+static void
+InventoryClear(Inventory *inventory){
+    if(NULL != inventory->snapshot_view){
+        PlatformFileUnmap(inventory->snapshot_view, inventory->snapshot_view_size);
+        inventory->snapshot_view = NULL;
+        inventory->snapshot_view_size = 0;
+    }else if(NULL != inventory->index_slots){
+        free(inventory->index_slots);
+    }
+    
+    InventoryColumn columns[INVENTORY_COLUMN_MAX];
+    InventoryGetColumns(inventory, columns);
+    for(int column_index = 0;
+        column_index < INVENTORY_COLUMN_MAX;
+        column_index += 1){
+        *columns[column_index].data = NULL;
+    }
+    inventory->items_count = 0;
+    ArenaReset(&inventory->columns_arena);
+    
+    inventory->strings = NULL;
+    inventory->strings_size = 0;
+    ArenaReset(&inventory->strings_arena);
+    
+    inventory->index_slots = NULL;
+    inventory->index_capacity = 0;
+    inventory->index_count = 0;
+}
+
+// NOTE(tbt): allocate zeroed columns for items_count items, including the dummy items, which are set up
+//            here. each column starts on a cache line. returns false, leaving the inventory cleared, if there
+//            isn't room for them
+static bool
+InventoryAllocate(Inventory *inventory,
+                  size_t items_count){
+    InventoryClear(inventory);
+    
+    bool is_success = true;
+    InventoryColumn columns[INVENTORY_COLUMN_MAX];
+    InventoryGetColumns(inventory, columns);
+    for(int column_index = 0;
+        column_index < INVENTORY_COLUMN_MAX;
+        column_index += 1){
+        *columns[column_index].data = ArenaPush(&inventory->columns_arena, InventoryColumnSize(columns[column_index], items_count));
+        if(NULL == *columns[column_index].data){
+            is_success = false;
+        }
+    }
+    inventory->strings = ArenaPush(&inventory->strings_arena, 1);
+    if(NULL == inventory->strings){
+        is_success = false;
+    }
+    
+    if(is_success){
+        inventory->items_count = items_count;
+        inventory->strings_size = 1;
+        
+        // NOTE(tbt): the inventory stores 2 'dummy' items which can be used to represent
+        //            errors in the final receipt
+        inventory->errors[DUMMY_INVENTORY_ITEM_ITEM_NOT_FOUND] = RECEIPT_ITEM_ERROR_ITEM_NOT_FOUND;
+        inventory->errors[DUMMY_INVENTORY_ITEM_INVALID_CODE] = RECEIPT_ITEM_ERROR_INVALID_GTIN8_CODE;
+    }else{
+        InventoryClear(inventory);
+    }
+    
+    return is_success;
+}
+
+static char *
+InventoryItemName(Inventory *inventory,
+                  size_t item_index){
+    return inventory->strings + inventory->name_offsets[item_index];
+}
+
+// NOTE(tbt): open addressing table of the names already in an inventory's string pool, used to intern names
+//            while the pool is being built. an offset of 0 marks an empty slot
+typedef struct InventoryNameTableSlot{
+    uint32_t hash;
+    uint32_t offset;
+}InventoryNameTableSlot;
+
+typedef struct InventoryNameTable{
+    InventoryNameTableSlot *slots;
+    size_t capacity; // NOTE(tbt): always a power of 2
+}InventoryNameTable;
+
+// NOTE(tbt): sized for names_count names up front, at a load factor of at most 1/2
+static InventoryNameTable
+InventoryNameTableMake(size_t names_count){
+    InventoryNameTable result = { .capacity = 1024, };
+    while(names_count*2 > result.capacity){
+        result.capacity *= 2;
+    }
+    result.slots = calloc(result.capacity, sizeof(result.slots[0]));
+    return result;
+}
+
+static void
+InventoryNameTableRelease(InventoryNameTable *table){
+    if(NULL != table->slots){
+        free(table->slots);
+    }
+    table->slots = NULL;
+    table->capacity = 0;
+}
+
+// NOTE(tbt): returns the offset of name in the inventory's string pool, adding it if it isn't already there.
+//            the table can hold at most the number of names it was made for
+static uint32_t
+InventoryInternName(Inventory *inventory,
+                    InventoryNameTable *table,
+                    const char *name){
+    uint32_t result = 0;
+    
+    // NOTE(tbt): FNV-1a, computed in the same pass as the length
+    uint32_t hash = 2166136261u;
+    size_t length = 0;
+    while('\0' != name[length]){
+        hash ^= (unsigned char)name[length];
+        hash *= 16777619u;
+        length += 1;
+    }
+    
+    if(length > 0 && NULL != table->slots){
+        size_t mask = table->capacity - 1;
+        size_t slot_index = (hash ^ (hash >> 15)) & mask;
+        while(0 != table->slots[slot_index].offset &&
+              (hash != table->slots[slot_index].hash ||
+               0 != strcmp(inventory->strings + table->slots[slot_index].offset, name))){
+            slot_index = (slot_index + 1) & mask;
+        }
+        
+        if(0 != table->slots[slot_index].offset){
+            result = table->slots[slot_index].offset;
+        }else if(inventory->strings_size + length + 1 <= UINT32_MAX){
+            char *copy = ArenaPushNoZero(&inventory->strings_arena, length + 1);
+            if(NULL != copy){
+                memcpy(copy, name, length + 1);
+                inventory->strings = inventory->strings_arena.base;
+                result = (uint32_t)(copy - inventory->strings);
+                inventory->strings_size = inventory->strings_arena.used;
+                table->slots[slot_index].hash = hash;
+                table->slots[slot_index].offset = result;
+            }
+        }
+    }
+    
+    return result;
+}
+
+// NOTE(tbt): pack the first 8 characters of a GTIN-8 code in to its numeric value. returns false if they
+//            aren't all digits
+static bool
+GTIN8PackCode(const char *code,
+              uint32_t *result){
+    bool is_valid = true;
+    uint32_t value = 0;
+    for(int i = 0;
+        i < 8 && is_valid;
+        i += 1){
+        unsigned int digit = (unsigned char)code[i] - '0';
+        if(digit > 9){
+            is_valid = false;
+        }
+        value = value*10 + digit;
+    }
+    *result = value;
+    return is_valid;
+}
+
+static size_t
+InventoryIndexSlotFromCode(Inventory *inventory,
+                           uint32_t code){
+    // NOTE(tbt): multiply by 2^32/phi to mix the digits in to the high bits, then fold them back down
+    size_t mask = inventory->index_capacity - 1;
+    uint32_t hash = code*2654435769u;
+    size_t slot_index = (hash ^ (hash >> 15)) & mask;
+    while(0 != inventory->index_slots[slot_index].item_index &&
+          code != inventory->index_slots[slot_index].code){
+        slot_index = (slot_index + 1) & mask;
+    }
+    return slot_index;
+}
+
+// NOTE(tbt): index every item with an 8 digit code, keeping the load factor under 1/2 so probe sequences
+//            stay short. the first item with a given code wins, the same as a linear search would find
+static void
+InventoryIndexBuild(Inventory *inventory){
+    if(NULL != inventory->index_slots){
+        free(inventory->index_slots);
+    }
+    inventory->index_capacity = 1024;
+    while(inventory->items_count*2 > inventory->index_capacity){
+        inventory->index_capacity *= 2;
+    }
+    inventory->index_slots = calloc(inventory->index_capacity, sizeof(inventory->index_slots[0]));
+    inventory->index_count = 0;
+    
+    if(NULL == inventory->index_slots){
+        inventory->index_capacity = 0;
+    }else{
+        for(size_t i = DUMMY_INVENTORY_ITEM_MAX;
+            i < inventory->items_count;
+            i += 1){
+            uint32_t code;
+            if(GTIN8PackCode(inventory->codes[i].digits, &code)){
+                InventoryIndexSlot *slot = &inventory->index_slots[InventoryIndexSlotFromCode(inventory, code)];
+                if(0 == slot->item_index){
+                    slot->code = code;
+                    slot->item_index = i;
+                    inventory->index_count += 1;
+                }
+            }
+        }
+    }
+}
+
+static int
+CountTrailingZeros64(uint64_t value){
+#if defined(_MSC_VER)
+    unsigned long result;
+    _BitScanForward64(&result, value);
+    return result;
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// NOTE(tbt): write the offset of every ',' and '\n' in data to positions, returning how many there were.
+//            nothing past size is read, as the bytes after a chunk of a file can belong to another thread
+static size_t
+StructuralIndexBuild(const char *data,
+                     size_t size,
+                     uint32_t *positions){
+    size_t positions_count = 0;
+    size_t full_blocks_size = size & ~(size_t)63;
+    for(size_t block_start = 0;
+        block_start < full_blocks_size;
+        block_start += 64){
+        uint64_t mask = 0;
+#if ARCH_X86
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i newline = _mm_set1_epi8('\n');
+        for(int i = 0;
+            i < 4;
+            i += 1){
+            __m128i bytes = _mm_loadu_si128((const __m128i *)&data[block_start + i*16]);
+            __m128i is_structural = _mm_or_si128(_mm_cmpeq_epi8(bytes, comma), _mm_cmpeq_epi8(bytes, newline));
+            mask |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_structural) << (i*16);
+        }
+#else
+        for(int i = 0;
+            i < 64;
+            i += 1){
+            char c = data[block_start + i];
+            mask |= (uint64_t)(',' == c || '\n' == c) << i;
+        }
+#endif
+        while(0 != mask){
+            positions[positions_count] = block_start + CountTrailingZeros64(mask);
+            positions_count += 1;
+            mask &= mask - 1;
+        }
+    }
+    
+    // NOTE(tbt): the last partial block a byte at a time
+    for(size_t i = full_blocks_size;
+        i < size;
+        i += 1){
+        if(',' == data[i] || '\n' == data[i]){
+            positions[positions_count] = i;
+            positions_count += 1;
+        }
+    }
+    return positions_count;
+}
+
+static bool
+IsFieldWhitespace(char c){
+    return (' ' == c || '\t' == c || '\v' == c || '\r' == c);
+}
+
+// NOTE(tbt): parse an optionally signed decimal integer from the start of a field. returns NULL if there
+//            were no digits or the value overflowed
+static const char *
+ParseInteger(const char *at,
+             const char *end,
+             int *result){
+    bool is_negative = false;
+    if(at < end && ('-' == *at || '+' == *at)){
+        is_negative = ('-' == *at);
+        at += 1;
+    }
+    const char *digits_start = at;
+    int64_t value = 0;
+    while(at < end && (unsigned int)(*at - '0') <= 9 && value <= INT32_MAX){
+        value = value*10 + (*at - '0');
+        at += 1;
+    }
+    if(at == digits_start || value > (int64_t)INT32_MAX + is_negative){
+        at = NULL;
+    }else{
+        *result = is_negative ? (int)-value : (int)value;
+    }
+    return at;
+}
+
+// NOTE(tbt): prices are parsed straight in to minor units. digits past the second decimal place round the
+//            price half away from zero, going by the exact decimal value written. anything more exotic (i.e.
+//            with an exponent) falls back to strtod()
+static const char *
+ParseMoney(const char *at,
+           const char *end,
+           Money *result){
+    const char *start = at;
+    bool is_negative = false;
+    if(at < end && ('-' == *at || '+' == *at)){
+        is_negative = ('-' == *at);
+        at += 1;
+    }
+    bool is_overflow = false;
+    int digits_count = 0;
+    Money whole = 0;
+    while(at < end && (unsigned int)(*at - '0') <= 9){
+        // NOTE(tbt): leave room for the fraction, which might have rounded up to 100
+        if(whole > (INT64_MAX / 100 - 1 - 9) / 10){
+            is_overflow = true;
+        }else{
+            whole = whole*10 + (*at - '0');
+        }
+        digits_count += 1;
+        at += 1;
+    }
+    Money fraction = 0;
+    if(at < end && '.' == *at){
+        at += 1;
+        int fraction_digits_count = 0;
+        while(at < end && (unsigned int)(*at - '0') <= 9){
+            if(fraction_digits_count < 2){
+                fraction = fraction*10 + (*at - '0');
+            }else if(2 == fraction_digits_count && *at >= '5'){
+                fraction += 1;
+            }
+            fraction_digits_count += 1;
+            at += 1;
+        }
+        if(1 == fraction_digits_count){
+            fraction *= 10;
+        }
+        digits_count += fraction_digits_count;
+    }
+    
+    if(0 == digits_count || is_overflow){
+        at = NULL;
+    }else if(at == end || ('e' != *at && 'E' != *at)){
+        Money value = whole*100 + fraction;
+        *result = is_negative ? -value : value;
+    }else{
+        char *end_ptr;
+        double value = strtod(start, &end_ptr)*100.0;
+        if(value > -9.0e18 && value < 9.0e18){
+            *result = (Money)((value < 0.0) ? value - 0.5 : value + 0.5);
+            at = end_ptr;
+        }else{
+            at = NULL;
+        }
+    }
+    return at;
+}
+
+// NOTE(tbt): trailing whitespace after a number is fine, anything else in the field is a parse error
+static bool
+IsRestOfFieldWhitespace(const char *at,
+                        const char *end){
+    while(at < end && IsFieldWhitespace(*at)){
+        at += 1;
+    }
+    return (at == end);
+}
+
+enum{
+    INVENTORY_FIELD_GTIN8_CODE,
+    INVENTORY_FIELD_NAME,
+    INVENTORY_FIELD_PRICE,
+    INVENTORY_FIELD_QTY,
+    INVENTORY_FIELD_RESTOCK_LEVEL,
+    INVENTORY_FIELD_TARGET_STOCK,
+    
+    INVENTORY_FIELD_MAX
+};
+
+// NOTE(tbt): strings is the buffer the field is in, which names are stored as offsets in to. the byte
+//            after the field (the ',' or '\n' which ended it) may be overwritten with a null terminator
+static void
+InventoryRecordParseField(InventoryRecord *record,
+                          int field_index,
+                          char *strings,
+                          char *field,
+                          char *field_end){
+    if(INVENTORY_FIELD_GTIN8_CODE == field_index){
+        size_t length = field_end - field;
+        if(length > 8){
+            length = 8;
+            record->error = RECEIPT_ITEM_ERROR_PARSE_ERROR;
+        }
+        memcpy(record->code.digits, field, length);
+    }else if(INVENTORY_FIELD_NAME == field_index){
+        if(field_end - field > INVENTORY_MAX_NAME_SIZE - 1){
+            record->error = RECEIPT_ITEM_ERROR_PARSE_ERROR;
+        }
+        record->name_offset = field - strings;
+        *field_end = '\0';
+    }else if(INVENTORY_FIELD_PRICE == field_index){
+        const char *number_end = ParseMoney(field, field_end, &record->unit_price);
+        if(NULL == number_end || !IsRestOfFieldWhitespace(number_end, field_end)){
+            record->error = RECEIPT_ITEM_ERROR_PARSE_ERROR;
+        }
+    }else if(INVENTORY_FIELD_QTY <= field_index && field_index < INVENTORY_FIELD_MAX){
+        int *fields[] = {
+            [INVENTORY_FIELD_QTY] = &record->qty,
+            [INVENTORY_FIELD_RESTOCK_LEVEL] = &record->restock_level,
+            [INVENTORY_FIELD_TARGET_STOCK] = &record->target_stock,
+        };
+        const char *number_end = ParseInteger(field, field_end, fields[field_index]);
+        if(NULL == number_end || !IsRestOfFieldWhitespace(number_end, field_end)){
+            record->error = RECEIPT_ITEM_ERROR_PARSE_ERROR;
+        }
+    }else if(!IsRestOfFieldWhitespace(field, field_end)){
+        // NOTE(tbt): lines may end with a trailing comma, but any more fields than that are an error
+        record->error = RECEIPT_ITEM_ERROR_PARSE_ERROR;
+    }
+}
+
+enum{
+    READ_FILE_PADDING = 64,
+};
+
+// NOTE(tbt): reads the entire file in to a buffer with a null byte before the contents (so that a name
+//            offset of 0 is always an empty string), and zeroed padding after. free it with
+//            ReleaseFileForParsing()
+static char *
+ReadEntireFileForParsing(char *path,
+                         size_t *file_size){
+    char *result = NULL;
+    *file_size = 0;
+    
+    PlatformFile file = PlatformFileOpen(path, PLATFORM_FILE_MODE_READ);
+    if(PLATFORM_FILE_INVALID != file){
+        uint64_t size;
+        if(PlatformFileGetSize(file, &size)){
+            result = PlatformMemoryAllocate(size + 1 + READ_FILE_PADDING);
+        }
+        if(NULL != result){
+            size_t bytes_read = 0;
+            bool is_success = true;
+            while(is_success && bytes_read < size){
+                size_t n_bytes_read;
+                if(!PlatformFileRead(file, result + 1 + bytes_read, size - bytes_read, &n_bytes_read) ||
+                   0 == n_bytes_read){
+                    is_success = false;
+                }
+                bytes_read += n_bytes_read;
+            }
+            if(is_success){
+                *file_size = bytes_read;
+            }else{
+                PlatformMemoryRelease(result, size + 1 + READ_FILE_PADDING);
+                result = NULL;
+            }
+        }
+        PlatformFileClose(file);
+    }
+    
+    return result;
+}
+
+static void
+ReleaseFileForParsing(char *data,
+                      size_t file_size){
+    PlatformMemoryRelease(data, file_size + 1 + READ_FILE_PADDING);
+}
+
+// NOTE(tbt): a newline aligned chunk of the inventory file, parsed on its own thread in to its own block of
+//            records. chunk_start and chunk_end are offsets in to strings
+typedef struct InventoryParseJob{
+    char *strings;
+    size_t chunk_start;
+    size_t chunk_end;
+    Arena records_arena;
+    size_t records_count;
+    bool is_out_of_memory; // NOTE(tbt): there wasn't room for every record, so the chunk wasn't finished
+}InventoryParseJob;
+
+static InventoryRecord *
+InventoryParseJobPushRecord(InventoryParseJob *job){
+    InventoryRecord *result = ArenaPush(&job->records_arena, sizeof(InventoryRecord));
+    if(NULL != result){
+        job->records_count += 1;
+    }
+    return result;
+}
+
+// NOTE(tbt): the chunk is parsed in place - a vectorised pass finds every ',' and '\n' a block at a time,
+//            then fields are sliced out between them. names are left where they are in the file buffer until
+//            they are interned, null terminated by overwriting the ',' after them
+static void
+InventoryParseThreadProc(void *param){
+    enum{ BLOCK_SIZE = 1 << 16, };
+    
+    InventoryParseJob *job = param;
+    char *strings = job->strings;
+    uint32_t *positions = PlatformMemoryAllocate(BLOCK_SIZE*sizeof(positions[0]));
+    
+    InventoryRecord *record = NULL;
+    int field_index = 0;
+    size_t field_start = job->chunk_start;
+    
+    for(size_t block_start = job->chunk_start;
+        block_start < job->chunk_end && !job->is_out_of_memory;
+        block_start += BLOCK_SIZE){
+        size_t block_size = (job->chunk_end - block_start > BLOCK_SIZE) ? BLOCK_SIZE : job->chunk_end - block_start;
+        size_t positions_count = StructuralIndexBuild(&strings[block_start], block_size, positions);
+        
+        for(size_t position_index = 0;
+            position_index < positions_count;
+            position_index += 1){
+            size_t position = block_start + positions[position_index];
+            char c = strings[position];
+            
+            if(NULL == record){
+                if('\n' == c && position == field_start){
+                    // NOTE(tbt): skip blank lines
+                    field_start = position + 1;
+                    continue;
+                }
+                record = InventoryParseJobPushRecord(job);
+                if(NULL == record){
+                    job->is_out_of_memory = true;
+                    break;
+                }
+            }
+            
+            InventoryRecordParseField(record, field_index, strings, &strings[field_start], &strings[position]);
+            
+            if(',' == c){
+                field_index += 1;
+                field_start = position + 1;
+                // NOTE(tbt): skip over white space after commas
+                while(field_start < job->chunk_end &&
+                      (' '  == strings[field_start] ||
+                       '\t' == strings[field_start] ||
+                       '\v' == strings[field_start])){
+                    field_start += 1;
+                }
+            }else{
+                record = NULL;
+                field_index = 0;
+                field_start = position + 1;
+            }
+        }
+    }
+    
+    // NOTE(tbt): the last line of the file doesn't need a trailing newline. there is always padding after
+    //            the end of the file for the null terminator, should the final field be a name
+    if(!job->is_out_of_memory && (NULL != record || field_start < job->chunk_end)){
+        if(NULL == record){
+            record = InventoryParseJobPushRecord(job);
+        }
+        if(NULL != record){
+            InventoryRecordParseField(record, field_index, strings, &strings[field_start], &strings[job->chunk_end]);
+        }else{
+            job->is_out_of_memory = true;
+        }
+    }
+    
+    PlatformMemoryRelease(positions, BLOCK_SIZE*sizeof(positions[0]));
+}
+
+// NOTE(tbt): the file is split in to one newline aligned chunk per core (for files big enough to be worth
+//            it), each of which is parsed in to a separate block of records. the blocks are then split in to
+//            the inventory's columns after the dummy items in file order, interning names as they go, after
+//            which the file buffer is no longer needed. returns false if the file couldn't be read or there
+//            isn't room for it, in which case the inventory is left with just the dummy items
+static bool
+InventoryParseFile(Inventory *inventory,
+                   char *path){
+    enum{
+        MAX_THREADS = 64,
+        MIN_CHUNK_SIZE = 1 << 20,
+    };
+    
+    size_t file_size;
+    char *strings = ReadEntireFileForParsing(path, &file_size);
+    
+    InventoryParseJob jobs[MAX_THREADS];
+    int jobs_count = 0;
+    
+    if(NULL != strings){
+        int threads_count;{
+            threads_count = PlatformGetProcessorCount();
+            if(threads_count > file_size / MIN_CHUNK_SIZE){
+                threads_count = file_size / MIN_CHUNK_SIZE;
+            }
+            if(threads_count < 1){
+                threads_count = 1;
+            }else if(threads_count > MAX_THREADS){
+                threads_count = MAX_THREADS;
+            }
+        }
+        
+        // NOTE(tbt): offsets are in to strings, where the file starts at 1
+        PlatformThread threads[MAX_THREADS];
+        bool is_thread_started[MAX_THREADS];
+        size_t chunk_start = 1;
+        for(int thread_index = 0;
+            thread_index < threads_count;
+            thread_index += 1){
+            size_t chunk_end = 1 + file_size*(thread_index + 1)/threads_count;
+            while(chunk_end < 1 + file_size && '\n' != strings[chunk_end - 1]){
+                chunk_end += 1;
+            }
+            if(chunk_start < chunk_end){
+                jobs[jobs_count] = (InventoryParseJob){
+                    .strings = strings,
+                    .chunk_start = chunk_start,
+                    .chunk_end = chunk_end,
+                };
+                jobs_count += 1;
+            }
+            chunk_start = chunk_end;
+        }
+        
+        // NOTE(tbt): the calling thread takes the first chunk itself
+        for(int job_index = 1;
+            job_index < jobs_count;
+            job_index += 1){
+            is_thread_started[job_index] = PlatformThreadCreate(&threads[job_index], InventoryParseThreadProc, &jobs[job_index]);
+            if(!is_thread_started[job_index]){
+                InventoryParseThreadProc(&jobs[job_index]);
+            }
+        }
+        if(jobs_count > 0){
+            InventoryParseThreadProc(&jobs[0]);
+        }
+        for(int job_index = 1;
+            job_index < jobs_count;
+            job_index += 1){
+            if(is_thread_started[job_index]){
+                PlatformThreadJoin(threads[job_index]);
+            }
+        }
+    }
+    
+    size_t records_count = 0;
+    bool is_allocated = true;
+    for(int job_index = 0;
+        job_index < jobs_count;
+        job_index += 1){
+        records_count += jobs[job_index].records_count;
+        if(jobs[job_index].is_out_of_memory){
+            is_allocated = false;
+        }
+    }
+    is_allocated = is_allocated && InventoryAllocate(inventory, DUMMY_INVENTORY_ITEM_MAX + records_count);
+    if(!is_allocated){
+        InventoryAllocate(inventory, DUMMY_INVENTORY_ITEM_MAX);
+    }
+    
+    InventoryNameTable name_table = InventoryNameTableMake(records_count);
+    size_t item_index = DUMMY_INVENTORY_ITEM_MAX;
+    for(int job_index = 0;
+        job_index < jobs_count;
+        job_index += 1){
+        InventoryRecord *records = (InventoryRecord *)jobs[job_index].records_arena.base;
+        for(size_t record_index = 0;
+            record_index < jobs[job_index].records_count && is_allocated;
+            record_index += 1){
+            InventoryRecord *record = &records[record_index];
+            inventory->errors[item_index] = record->error;
+            inventory->codes[item_index] = record->code;
+            inventory->name_offsets[item_index] = InventoryInternName(inventory, &name_table, strings + record->name_offset);
+            inventory->unit_prices[item_index] = record->unit_price;
+            inventory->qtys[item_index] = record->qty;
+            inventory->restock_levels[item_index] = record->restock_level;
+            inventory->target_stocks[item_index] = record->target_stock;
+            item_index += 1;
+        }
+        ArenaRelease(&jobs[job_index].records_arena);
+    }
+    InventoryNameTableRelease(&name_table);
+    
+    bool is_success = (NULL != strings && is_allocated);
+    if(NULL != strings){
+        ReleaseFileForParsing(strings, file_size);
+    }
+    
+    InventoryIndexBuild(inventory);
+    
+    return is_success;
+}
+
+////////////////////////////////
+//~NOTE(tbt): inventory snapshots
+
+// NOTE(tbt): after the inventory file is parsed, a snapshot of the result is written alongside it. each
+//            column is stored as an array, followed by the string pool and then the GTIN index, so the next
+//            load can map the file copy-on-write and use it in place without parsing or building anything.
+//            the snapshot records the size and last write time of the csv it was made from, and is ignored if
+//            the csv has changed since.
+//
+//            snapshots are written to a temporary file which is then renamed over the old one, so a snapshot
+//            is never seen half written. the checksum covers the header, so that opening stays O(1) - a
+//            corrupt or truncated header, or one from a different build, is caught by it along with the
+//            version and column count.
+
+enum{
+    INVENTORY_SNAPSHOT_VERSION = 3,
+    INVENTORY_SNAPSHOT_ALIGNMENT = INVENTORY_COLUMN_ALIGNMENT,
+};
+
+static const char g_inventory_snapshot_magic[8] = { 'G', 'T', 'I', 'N', '8', 'I', 'N', 'V' };
+
+typedef struct InventorySnapshotHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t columns_count;
+    uint32_t index_slot_size;
+    
+    uint64_t csv_size;
+    uint64_t csv_write_time;
+    
+    uint64_t items_count;
+    uint64_t column_offsets[INVENTORY_COLUMN_MAX];
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t index_offset;
+    uint64_t index_capacity;
+    uint64_t index_count;
+    
+    uint64_t file_size;
+    uint64_t checksum;
+}InventorySnapshotHeader;
+
+// NOTE(tbt): FNV-1a
+static uint64_t
+Checksum64(const void *data,
+           size_t size){
+    uint64_t result = 14695981039346656037ull;
+    const unsigned char *bytes = data;
+    for(size_t i = 0;
+        i < size;
+        i += 1){
+        result ^= bytes[i];
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+static uint64_t
+InventorySnapshotHeaderChecksum(InventorySnapshotHeader header){
+    header.checksum = 0;
+    return Checksum64(&header, sizeof(header));
+}
+
+static void
+InventorySnapshotPathFromCSVPath(char *csv_path,
+                                 char *buffer,
+                                 size_t buffer_size){
+    snprintf(buffer, buffer_size, "%s.snapshot", csv_path);
+}
+
+static void
+OutputBufferWritePadding(OutputBuffer *output,
+                         uint64_t *offset,
+                         size_t alignment){
+    static const char zeroes[INVENTORY_SNAPSHOT_ALIGNMENT] = {0};
+    size_t padding = (alignment - (*offset % alignment)) % alignment;
+    OutputBufferWrite(output, zeroes, padding);
+    *offset += padding;
+}
+
+static void
+InventoryWriteSnapshot(Inventory *inventory,
+                       char *csv_path){
+    enum{ OUTPUT_BUFFER_SIZE = 1 << 22, };
+    
+    char snapshot_path[PLATFORM_MAX_PATH];
+    char temporary_path[PLATFORM_MAX_PATH];
+    InventorySnapshotPathFromCSVPath(csv_path, snapshot_path, sizeof(snapshot_path));
+    snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", snapshot_path);
+    
+    InventorySnapshotHeader header = {
+        .version = INVENTORY_SNAPSHOT_VERSION,
+        .header_size = sizeof(InventorySnapshotHeader),
+        .columns_count = INVENTORY_COLUMN_MAX,
+        .index_slot_size = sizeof(InventoryIndexSlot),
+        .items_count = inventory->items_count,
+        .index_capacity = inventory->index_capacity,
+        .index_count = inventory->index_count,
+    };
+    memcpy(header.magic, g_inventory_snapshot_magic, sizeof(header.magic));
+    
+    PlatformFile file = PLATFORM_FILE_INVALID;
+    if(PlatformGetFileSizeAndWriteTime(csv_path, &header.csv_size, &header.csv_write_time)){
+        file = PlatformFileOpen(temporary_path, PLATFORM_FILE_MODE_WRITE);
+    }
+    OutputBuffer output = {
+        .file = file,
+        .buffer = PlatformMemoryAllocate(OUTPUT_BUFFER_SIZE),
+        .size = OUTPUT_BUFFER_SIZE,
+    };
+    
+    if(PLATFORM_FILE_INVALID != file && NULL != output.buffer){
+        uint64_t offset = 0;
+        
+        // NOTE(tbt): the header is written again once all the offsets are known
+        OutputBufferWrite(&output, &header, sizeof(header));
+        offset += sizeof(header);
+        
+        InventoryColumn columns[INVENTORY_COLUMN_MAX];
+        InventoryGetColumns(inventory, columns);
+        for(int column_index = 0;
+            column_index < INVENTORY_COLUMN_MAX;
+            column_index += 1){
+            OutputBufferWritePadding(&output, &offset, INVENTORY_SNAPSHOT_ALIGNMENT);
+            header.column_offsets[column_index] = offset;
+            size_t size = inventory->items_count*columns[column_index].element_size;
+            OutputBufferWrite(&output, *columns[column_index].data, size);
+            offset += size;
+        }
+        
+        header.strings_offset = offset;
+        header.strings_size = inventory->strings_size;
+        OutputBufferWrite(&output, inventory->strings, inventory->strings_size);
+        offset += inventory->strings_size;
+        
+        OutputBufferWritePadding(&output, &offset, INVENTORY_SNAPSHOT_ALIGNMENT);
+        header.index_offset = offset;
+        OutputBufferWrite(&output, inventory->index_slots, inventory->index_capacity*sizeof(InventoryIndexSlot));
+        offset += inventory->index_capacity*sizeof(InventoryIndexSlot);
+        
+        OutputBufferFlush(&output);
+        
+        header.file_size = offset;
+        header.checksum = InventorySnapshotHeaderChecksum(header);
+        bool is_success = !output.is_error && PlatformFileWriteAt(file, 0, &header, sizeof(header));
+        
+        PlatformFileClose(file);
+        
+        // NOTE(tbt): windows won't replace a file which is mapped. if the inventory's columns are in a view of
+        //            the old snapshot (e.g. this is a compaction's copy of it), the new one is left where it is
+        //            for InventoryLoad() to put in place once the view has been released
+        if(!is_success ||
+           (NULL == inventory->snapshot_view && !PlatformFileReplace(temporary_path, snapshot_path))){
+            PlatformFileDelete(temporary_path);
+        }
+    }else if(PLATFORM_FILE_INVALID != file){
+        PlatformFileClose(file);
+        PlatformFileDelete(temporary_path);
+    }
+    
+    if(NULL != output.buffer){
+        PlatformMemoryRelease(output.buffer, OUTPUT_BUFFER_SIZE);
+    }
+}
+
+// NOTE(tbt): map the snapshot for csv_path copy-on-write, pointing the inventory's columns, strings and index
+//            straight in to the view. changes to the inventory only ever touch private copies of pages, never
+//            the file. returns false if there is no snapshot or it doesn't match the csv
+static bool
+InventoryOpenSnapshot(Inventory *inventory,
+                      char *csv_path){
+    bool is_success = false;
+    
+    char snapshot_path[PLATFORM_MAX_PATH];
+    InventorySnapshotPathFromCSVPath(csv_path, snapshot_path, sizeof(snapshot_path));
+    
+    uint64_t csv_size, csv_write_time;
+    if(PlatformGetFileSizeAndWriteTime(csv_path, &csv_size, &csv_write_time)){
+        uint64_t snapshot_size;
+        char *view = PlatformFileMapCopyOnWrite(snapshot_path, &snapshot_size);
+        
+        if(NULL != view && snapshot_size < sizeof(InventorySnapshotHeader)){
+            PlatformFileUnmap(view, snapshot_size);
+        }else if(NULL != view){
+            InventorySnapshotHeader *header = (InventorySnapshotHeader *)view;
+            if(0 == memcmp(header->magic, g_inventory_snapshot_magic, sizeof(header->magic)) &&
+               INVENTORY_SNAPSHOT_VERSION == header->version &&
+               sizeof(InventorySnapshotHeader) == header->header_size &&
+               INVENTORY_COLUMN_MAX == header->columns_count &&
+               sizeof(InventoryIndexSlot) == header->index_slot_size &&
+               InventorySnapshotHeaderChecksum(*header) == header->checksum &&
+               snapshot_size == header->file_size &&
+               csv_size == header->csv_size &&
+               csv_write_time == header->csv_write_time){
+                InventoryClear(inventory);
+                inventory->snapshot_view = view;
+                inventory->snapshot_view_size = snapshot_size;
+                InventoryColumn columns[INVENTORY_COLUMN_MAX];
+                InventoryGetColumns(inventory, columns);
+                for(int column_index = 0;
+                    column_index < INVENTORY_COLUMN_MAX;
+                    column_index += 1){
+                    *columns[column_index].data = view + header->column_offsets[column_index];
+                }
+                inventory->items_count = header->items_count;
+                inventory->strings = view + header->strings_offset;
+                inventory->strings_size = header->strings_size;
+                inventory->index_slots = (InventoryIndexSlot *)(view + header->index_offset);
+                inventory->index_capacity = header->index_capacity;
+                inventory->index_count = header->index_count;
+                is_success = true;
+            }else{
+                PlatformFileUnmap(view, snapshot_size);
+            }
+        }
+    }
+    
+    return is_success;
+}
+
+static void
+OutputBufferWriteGTIN8Code(OutputBuffer *output,
+                           GTIN8Code *code){
+    size_t length = 0;
+    while(length < sizeof(code->digits) && '\0' != code->digits[length]){
+        length += 1;
+    }
+    OutputBufferWrite(output, code->digits, length);
+}
+
+static bool
+InventorySerialiseFile(Inventory *inventory,
+                       char *path){
+    enum{ OUTPUT_BUFFER_SIZE = 1 << 22, };
+    
+    bool is_success = false;
+    PlatformFile file = PlatformFileOpen(path, PLATFORM_FILE_MODE_WRITE);
+    if(PLATFORM_FILE_INVALID != file){
+        OutputBuffer output = {
+            .file = file,
+            .buffer = PlatformMemoryAllocate(OUTPUT_BUFFER_SIZE),
+            .size = OUTPUT_BUFFER_SIZE,
+        };
+        if(NULL != output.buffer){
+            for(size_t i = DUMMY_INVENTORY_ITEM_MAX;
+                i < inventory->items_count;
+                i += 1){
+                OutputBufferWriteGTIN8Code(&output, &inventory->codes[i]);
+                OutputBufferWriteLiteral(&output, ", ");
+                OutputBufferWriteString(&output, InventoryItemName(inventory, i));
+                OutputBufferWriteLiteral(&output, ", ");
+                OutputBufferWriteMoney(&output, inventory->unit_prices[i]);
+                OutputBufferWriteLiteral(&output, ", ");
+                OutputBufferWriteInteger(&output, inventory->qtys[i]);
+                OutputBufferWriteLiteral(&output, ", ");
+                OutputBufferWriteInteger(&output, inventory->restock_levels[i]);
+                OutputBufferWriteLiteral(&output, ", ");
+                OutputBufferWriteInteger(&output, inventory->target_stocks[i]);
+                OutputBufferWriteLiteral(&output, ",\n");
+            }
+            OutputBufferFlush(&output);
+            is_success = !output.is_error;
+            PlatformMemoryRelease(output.buffer, OUTPUT_BUFFER_SIZE);
+        }
+        PlatformFileClose(file);
+    }
+    return is_success;
+}
+
+// NOTE(tbt): returns the index of the item with the given code, or of the dummy item for the error
+static size_t
+InventoryItemFromGTIN8Code(Inventory *inventory,
+                           char gtin8_code[9]){
+    size_t result = DUMMY_INVENTORY_ITEM_ITEM_NOT_FOUND;
+    uint32_t code;
+    if(VERIFY_GTIN8_RESULT_SUCCESS == GTIN8Verify(gtin8_code) &&
+       GTIN8PackCode(gtin8_code, &code)){
+        if(inventory->index_capacity > 0){
+            InventoryIndexSlot *slot = &inventory->index_slots[InventoryIndexSlotFromCode(inventory, code)];
+            if(0 != slot->item_index){
+                result = slot->item_index;
+            }
+        }
+    }else{
+        result = DUMMY_INVENTORY_ITEM_INVALID_CODE;
+    }
+    return result;
+}
+
+////////////////////////////////
+//~NOTE(tbt): inventory journal
+
+// NOTE(tbt): rather than rewriting the whole csv every time stock changes, each change is appended to a
+//            journal alongside it, which is replayed on top of the csv (or its snapshot) when it is loaded.
+//            once the journal grows past a threshold it is compacted - renamed aside, then the current state
+//            of the inventory is written out as the new csv (and snapshot) on a background thread, after
+//            which the old journal is deleted.
+//
+//            records hold the resulting qty along with the change, and replay just sets the qty, so a record
+//            being replayed on top of a csv it has already been folded in to is harmless. that is what
+//            happens if the program stops part way through a compaction - the renamed journal is replayed
+//            and the compaction finished on the next load.
+
+enum{
+    INVENTORY_JOURNAL_VERSION = 1,
+    INVENTORY_JOURNAL_COMPACTION_THRESHOLD = 1 << 20,
+};
+
+static const char g_inventory_journal_magic[8] = { 'G', 'T', 'I', 'N', '8', 'J', 'N', 'L' };
+
+typedef struct InventoryJournalHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+}InventoryJournalHeader;
+
+typedef struct InventoryJournalRecord{
+    GTIN8Code code;
+    uint32_t item_index; // NOTE(tbt): where the item was when the record was written - checked against code before it is used
+    int32_t qty_change;
+    int32_t qty;
+    uint32_t reserved;
+    uint64_t timestamp;  // NOTE(tbt): from PlatformGetWallClock()
+}InventoryJournalRecord;
+
+// NOTE(tbt): a journal which is being appended to for a single save
+typedef struct InventoryJournal{
+    OutputBuffer output;
+    char buffer[1 << 16];
+    uint64_t timestamp;
+}InventoryJournal;
+
+// NOTE(tbt): state for a compaction running in the background. inventory is a shallow copy of the inventory
+//            being compacted, with its own copy of the qtys column, as the original carries on changing
+typedef struct InventoryCompaction{
+    Inventory inventory;
+    char csv_path[PLATFORM_MAX_PATH];
+}InventoryCompaction;
+
+static void
+InventoryJournalPathFromCSVPath(char *csv_path,
+                                char *buffer,
+                                size_t buffer_size){
+    snprintf(buffer, buffer_size, "%s.journal", csv_path);
+}
+
+static void
+InventoryCompactingJournalPathFromCSVPath(char *csv_path,
+                                          char *buffer,
+                                          size_t buffer_size){
+    snprintf(buffer, buffer_size, "%s.journal.compacting", csv_path);
+}
+
+static void
+InventoryJournalBegin(InventoryJournal *journal,
+                      char *csv_path){
+    char journal_path[PLATFORM_MAX_PATH];
+    InventoryJournalPathFromCSVPath(csv_path, journal_path, sizeof(journal_path));
+    
+    journal->output = (OutputBuffer){
+        .file = PlatformFileOpen(journal_path, PLATFORM_FILE_MODE_APPEND),
+        .buffer = journal->buffer,
+        .size = sizeof(journal->buffer),
+    };
+    
+    journal->timestamp = PlatformGetWallClock();
+    
+    if(PLATFORM_FILE_INVALID != journal->output.file){
+        uint64_t size;
+        if(PlatformFileGetSize(journal->output.file, &size) && 0 == size){
+            InventoryJournalHeader header = {
+                .version = INVENTORY_JOURNAL_VERSION,
+                .record_size = sizeof(InventoryJournalRecord),
+            };
+            memcpy(header.magic, g_inventory_journal_magic, sizeof(header.magic));
+            OutputBufferWrite(&journal->output, &header, sizeof(header));
+        }
+    }
+}
+
+// NOTE(tbt): set the qty of an item, recording the change in the journal. the dummy items are never journaled
+static void
+InventorySetQty(Inventory *inventory,
+                InventoryJournal *journal,
+                size_t item_index,
+                int32_t qty){
+    if(item_index >= DUMMY_INVENTORY_ITEM_MAX && item_index < inventory->items_count){
+        InventoryJournalRecord record = {
+            .code = inventory->codes[item_index],
+            .item_index = item_index,
+            .qty_change = qty - inventory->qtys[item_index],
+            .qty = qty,
+            .timestamp = journal->timestamp,
+        };
+        inventory->qtys[item_index] = qty;
+        if(PLATFORM_FILE_INVALID != journal->output.file){
+            OutputBufferWrite(&journal->output, &record, sizeof(record));
+        }
+    }
+}
+
+// NOTE(tbt): find the item a journal record refers to, which might have moved if the csv was edited by hand
+static size_t
+InventoryItemFromJournalRecord(Inventory *inventory,
+                               InventoryJournalRecord *record){
+    size_t result = DUMMY_INVENTORY_ITEM_ITEM_NOT_FOUND;
+    if(record->item_index >= DUMMY_INVENTORY_ITEM_MAX &&
+       record->item_index < inventory->items_count &&
+       0 == memcmp(inventory->codes[record->item_index].digits, record->code.digits, sizeof(record->code.digits))){
+        result = record->item_index;
+    }else{
+        uint32_t code;
+        if(GTIN8PackCode(record->code.digits, &code) && inventory->index_capacity > 0){
+            InventoryIndexSlot *slot = &inventory->index_slots[InventoryIndexSlotFromCode(inventory, code)];
+            result = slot->item_index;
+        }else{
+            for(size_t i = DUMMY_INVENTORY_ITEM_MAX;
+                i < inventory->items_count && DUMMY_INVENTORY_ITEM_ITEM_NOT_FOUND == result;
+                i += 1){
+                if(0 == memcmp(inventory->codes[i].digits, record->code.digits, sizeof(record->code.digits))){
+                    result = i;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// NOTE(tbt): apply every complete record in the journal at path to the inventory. returns false if there is
+//            no journal there
+static bool
+InventoryJournalReplay(Inventory *inventory,
+                       char *path){
+    bool result = false;
+    
+    size_t size;
+    char *data = ReadEntireFileForParsing(path, &size);
+    if(NULL != data){
+        result = true;
+        
+        // NOTE(tbt): the file starts 1 byte in to the buffer, so the header is copied out rather than read in place
+        InventoryJournalHeader header = {0};
+        if(size >= sizeof(header)){
+            memcpy(&header, data + 1, sizeof(header));
+        }
+        if(0 == memcmp(header.magic, g_inventory_journal_magic, sizeof(header.magic)) &&
+           INVENTORY_JOURNAL_VERSION == header.version &&
+           sizeof(InventoryJournalRecord) == header.record_size){
+            size_t records_count = (size - sizeof(header)) / sizeof(InventoryJournalRecord);
+            for(size_t record_index = 0;
+                record_index < records_count;
+                record_index += 1){
+                InventoryJournalRecord record;
+                memcpy(&record, data + 1 + sizeof(header) + record_index*sizeof(record), sizeof(record));
+                size_t item_index = InventoryItemFromJournalRecord(inventory, &record);
+                if(item_index >= DUMMY_INVENTORY_ITEM_MAX){
+                    inventory->qtys[item_index] = record.qty;
+                }
+            }
+        }
+        
+        ReleaseFileForParsing(data, size);
+    }
+    
+    return result;
+}
+
+// NOTE(tbt): write the compacted inventory out as the new csv, then a snapshot of it, and finally delete the
+//            journal which has been folded in to it
+static void
+InventoryCompactionThreadProc(void *param){
+    InventoryCompaction *compaction = param;
+    
+    char temporary_path[PLATFORM_MAX_PATH];
+    char compacting_journal_path[PLATFORM_MAX_PATH];
+    snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", compaction->csv_path);
+    InventoryCompactingJournalPathFromCSVPath(compaction->csv_path, compacting_journal_path, sizeof(compacting_journal_path));
+    
+    if(InventorySerialiseFile(&compaction->inventory, temporary_path) &&
+       PlatformFileReplace(temporary_path, compaction->csv_path)){
+        InventoryWriteSnapshot(&compaction->inventory, compaction->csv_path);
+        PlatformFileDelete(compacting_journal_path);
+    }else{
+        PlatformFileDelete(temporary_path);
+    }
+}
+
+// NOTE(tbt): wait for a background compaction to finish, if there is one. the inventory must not be cleared
+//            or reloaded while one is running, as the compaction shares its columns
+static void
+InventoryCompactionWait(Inventory *inventory){
+    if(0 != inventory->compaction_thread.handle){
+        PlatformThreadJoin(inventory->compaction_thread);
+        inventory->compaction_thread.handle = 0;
+    }
+    if(NULL != inventory->compaction){
+        PlatformMemoryRelease(inventory->compaction->inventory.qtys, inventory->compaction->inventory.items_count*sizeof(int32_t));
+        free(inventory->compaction);
+        inventory->compaction = NULL;
+    }
+}
+
+static void
+InventoryCompactionStart(Inventory *inventory,
+                         char *csv_path){
+    InventoryCompactionWait(inventory);
+    
+    InventoryCompaction *compaction = calloc(1, sizeof(*compaction));
+    int32_t *qtys = PlatformMemoryAllocate(inventory->items_count*sizeof(qtys[0]));
+    if(NULL != compaction && NULL != qtys){
+        memcpy(qtys, inventory->qtys, inventory->items_count*sizeof(qtys[0]));
+        compaction->inventory = *inventory;
+        compaction->inventory.qtys = qtys;
+        snprintf(compaction->csv_path, sizeof(compaction->csv_path), "%s", csv_path);
+        inventory->compaction = compaction;
+        
+        // NOTE(tbt): changes from here on go to a new journal. if a previous compaction failed, its journal is
+        //            still there and this one won't be renamed, but that is fine as replaying it is harmless
+        char journal_path[PLATFORM_MAX_PATH];
+        char compacting_journal_path[PLATFORM_MAX_PATH];
+        InventoryJournalPathFromCSVPath(csv_path, journal_path, sizeof(journal_path));
+        InventoryCompactingJournalPathFromCSVPath(csv_path, compacting_journal_path, sizeof(compacting_journal_path));
+        PlatformFileRename(journal_path, compacting_journal_path);
+        
+        if(!PlatformThreadCreate(&inventory->compaction_thread, InventoryCompactionThreadProc, compaction)){
+            inventory->compaction_thread.handle = 0;
+            InventoryCompactionThreadProc(compaction);
+        }
+    }else{
+        if(NULL != compaction){
+            free(compaction);
+        }
+        if(NULL != qtys){
+            PlatformMemoryRelease(qtys, inventory->items_count*sizeof(qtys[0]));
+        }
+    }
+}
+
+// NOTE(tbt): write out the records for this save, starting a compaction if the journal has grown too big
+static void
+InventoryJournalEnd(Inventory *inventory,
+                    InventoryJournal *journal,
+                    char *csv_path){
+    if(PLATFORM_FILE_INVALID != journal->output.file){
+        OutputBufferFlush(&journal->output);
+        uint64_t size;
+        bool is_compaction_needed = (PlatformFileGetSize(journal->output.file, &size) &&
+                                     size > INVENTORY_JOURNAL_COMPACTION_THRESHOLD);
+        PlatformFileClose(journal->output.file);
+        journal->output.file = PLATFORM_FILE_INVALID;
+        
+        if(is_compaction_needed){
+            InventoryCompactionStart(inventory, csv_path);
+        }
+    }
+}
+
+// NOTE(tbt): use the snapshot if it is up to date, otherwise parse the csv and write a new one. then replay the
+//            journal on top, finishing off a compaction which didn't complete last time if there was one. returns
+//            false if the csv couldn't be loaded - the inventory is left empty, and nothing is written over the
+//            csv or its snapshot
+static bool
+InventoryLoad(Inventory *inventory,
+              char *csv_path){
+    InventoryCompactionWait(inventory);
+    
+    // NOTE(tbt): release the old snapshot, then put in place a new one which was written while it was mapped.
+    //            if it is out of date or incomplete, InventoryOpenSnapshot() rejects it like any other
+    InventoryClear(inventory);
+    char snapshot_path[PLATFORM_MAX_PATH];
+    char pending_snapshot_path[PLATFORM_MAX_PATH];
+    InventorySnapshotPathFromCSVPath(csv_path, snapshot_path, sizeof(snapshot_path));
+    snprintf(pending_snapshot_path, sizeof(pending_snapshot_path), "%s.tmp", snapshot_path);
+    uint64_t pending_snapshot_size, pending_snapshot_write_time;
+    if(PlatformGetFileSizeAndWriteTime(pending_snapshot_path, &pending_snapshot_size, &pending_snapshot_write_time) &&
+       !PlatformFileReplace(pending_snapshot_path, snapshot_path)){
+        PlatformFileDelete(pending_snapshot_path);
+    }
+    
+    bool is_success = InventoryOpenSnapshot(inventory, csv_path);
+    if(!is_success){
+        is_success = InventoryParseFile(inventory, csv_path);
+        if(is_success){
+            InventoryWriteSnapshot(inventory, csv_path);
+        }
+    }
+    
+    if(is_success){
+        char journal_path[PLATFORM_MAX_PATH];
+        char compacting_journal_path[PLATFORM_MAX_PATH];
+        InventoryJournalPathFromCSVPath(csv_path, journal_path, sizeof(journal_path));
+        InventoryCompactingJournalPathFromCSVPath(csv_path, compacting_journal_path, sizeof(compacting_journal_path));
+        bool is_compaction_unfinished = InventoryJournalReplay(inventory, compacting_journal_path);
+        InventoryJournalReplay(inventory, journal_path);
+        
+        if(is_compaction_unfinished){
+            InventoryCompactionStart(inventory, csv_path);
+        }
+    }
+    
+    return is_success;
+}
+
+// NOTE(tbt): whether any item is below its restock level
+static bool
+InventoryIsRestockNeeded(Inventory *inventory){
+    bool result = false;
+    for(size_t i = DUMMY_INVENTORY_ITEM_MAX;
+        i < inventory->items_count && !result;
+        i += 1){
+        result = (RECEIPT_ITEM_ERROR_NONE == inventory->errors[i] &&
+                  inventory->qtys[i] < inventory->restock_levels[i]);
+    }
+    return result;
+}
+
+// NOTE(tbt): write out an order for enough stock to bring every item below its restock level back up to its
+//            target, and record that stock as received
+static void
+InventoryOrderRestock(Inventory *inventory,
+                      char *order_path,
+                      char *csv_path){
+    enum{ OUTPUT_BUFFER_SIZE = 1 << 22, };
+    
+    PlatformFile file = PlatformFileOpen(order_path, PLATFORM_FILE_MODE_WRITE);
+    if(PLATFORM_FILE_INVALID != file){
+        OutputBuffer output = {
+            .file = file,
+            .buffer = PlatformMemoryAllocate(OUTPUT_BUFFER_SIZE),
+            .size = OUTPUT_BUFFER_SIZE,
+        };
+        if(NULL != output.buffer){
+            InventoryJournal journal;
+            InventoryJournalBegin(&journal, csv_path);
+            
+            OutputBufferWriteLiteral(&output, "\"product code\",\"description\",\"qty\",\"price\",\"sub-total\",\n");
+            
+            Money total = 0;
+            for(size_t i = DUMMY_INVENTORY_ITEM_MAX;
+                i < inventory->items_count;
+                i += 1){
+                int qty = inventory->target_stocks[i] - inventory->qtys[i];
+                if(inventory->qtys[i] < inventory->restock_levels[i]){
+                    Money sub_total = qty * inventory->unit_prices[i];
+                    total += sub_total;
+                    
+                    OutputBufferWriteLiteral(&output, "\"");
+                    OutputBufferWriteGTIN8Code(&output, &inventory->codes[i]);
+                    OutputBufferWriteLiteral(&output, "\",\"");
+                    OutputBufferWriteString(&output, InventoryItemName(inventory, i));
+                    OutputBufferWriteLiteral(&output, "\",\"");
+                    OutputBufferWriteInteger(&output, qty);
+                    OutputBufferWriteLiteral(&output, "\",\"$");
+                    OutputBufferWriteMoney(&output, inventory->unit_prices[i]);
+                    OutputBufferWriteLiteral(&output, "\",\"$");
+                    OutputBufferWriteMoney(&output, sub_total);
+                    OutputBufferWriteLiteral(&output, "\",\n");
+                    
+                    InventorySetQty(inventory, &journal, i, inventory->target_stocks[i]);
+                }
+            }
+            
+            OutputBufferWriteLiteral(&output, "\"\",\"\",\"\",\"total:\",\"$");
+            OutputBufferWriteMoney(&output, total);
+            OutputBufferWriteLiteral(&output, "\",\n");
+            
+            OutputBufferFlush(&output);
+            PlatformMemoryRelease(output.buffer, OUTPUT_BUFFER_SIZE);
+            
+            InventoryJournalEnd(inventory, &journal, csv_path);
+        }
+        PlatformFileClose(file);
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): command line
+
+static PlatformFile
+FileFromCommandLinePath(char *path,
+                        bool is_output){
+    PlatformFile result = PLATFORM_FILE_INVALID;
+    if(0 == strcmp(path, "-")){
+        result = is_output ? PlatformFileStandardOutput() : PlatformFileStandardInput();
+    }else{
+        result = PlatformFileOpen(path, is_output ? PLATFORM_FILE_MODE_WRITE : PLATFORM_FILE_MODE_READ);
+    }
+    return result;
+}
+
+// NOTE(tbt): the program can be run without a window for batch processing:
+//
+//              gtin8_utils --verify [input] [output]
+//              gtin8_utils --generate <start prefix> <end prefix> [output] [--binary]
+//
+//            paths default to stdin/stdout, or - can be given explicitly. arguments are utf-8.
+//            returns true if the command line asked for a headless mode, in which case it has already been run
+static bool
+RunHeadlessCommandLine(int argc,
+                       char **argv,
+                       int *exit_code){
+    bool is_headless = false;
+    *exit_code = 0;
+    
+    if(argc >= 2){
+        if(0 == strcmp(argv[1], "--verify")){
+            is_headless = true;
+            char *input_path = argc > 2 ? argv[2] : "-";
+            char *output_path = argc > 3 ? argv[3] : "-";
+            PlatformFile input = FileFromCommandLinePath(input_path, false);
+            PlatformFile output = FileFromCommandLinePath(output_path, true);
+            if(PLATFORM_FILE_INVALID != input && PLATFORM_FILE_INVALID != output){
+                GTIN8VerifyStream(input, output);
+            }else{
+                *exit_code = 1;
+            }
+            if(0 != strcmp(input_path, "-") && PLATFORM_FILE_INVALID != input){ PlatformFileClose(input); }
+            if(0 != strcmp(output_path, "-") && PLATFORM_FILE_INVALID != output){ PlatformFileClose(output); }
+        }else if(0 == strcmp(argv[1], "--generate") && argc >= 4){
+            is_headless = true;
+            uint32_t start = strtoul(argv[2], NULL, 10);
+            uint32_t end = strtoul(argv[3], NULL, 10);
+            char *output_path = (argc > 4 && 0 != strcmp(argv[4], "--binary")) ? argv[4] : "-";
+            GTIN8GenerateFormat format = GTIN8_GENERATE_FORMAT_TEXT;
+            for(int arg_index = 4;
+                arg_index < argc;
+                arg_index += 1){
+                if(0 == strcmp(argv[arg_index], "--binary")){
+                    format = GTIN8_GENERATE_FORMAT_BINARY;
+                }
+            }
+            PlatformFile output = FileFromCommandLinePath(output_path, true);
+            if(PLATFORM_FILE_INVALID == output ||
+               !GTIN8GenerateRangeToFile(start, end, format, output)){
+                *exit_code = 1;
+            }
+            if(0 != strcmp(output_path, "-") && PLATFORM_FILE_INVALID != output){ PlatformFileClose(output); }
+        }
+    }
+    
+    return is_headless;
+}
@@ -0,0 +1,311 @@
+////////////////////////////////
+//~NOTE(tbt): headless entry point
+
+// NOTE(tbt): builds without a window system, e.g. on linux:
+//
+//              headless_gtin8_utils --verify [input] [output]
+//              headless_gtin8_utils --generate <start prefix> <end prefix> [output] [--binary]
+//              headless_gtin8_utils --render <frames> [menu|check-digit|verify|receipt|stock]
+//              headless_gtin8_utils --render-script [--frames <n>] [--dump <dir>] [--golden <dir>] [--timings <csv>]
+//              headless_gtin8_utils --dataset <items> <inventory csv> [--sales <count> <sales csv>] [--seed <n>]
+//                                   [--duplicates <rate>] [--corrupt <rate>] [--invalid <rate>] [--unknown <rate>]
+//
+//            --render draws frames of a screen in to an offscreen framebuffer, then prints how long they took
+//            along with a checksum of the final frame, so rendering can be profiled and compared between builds
+//
+//            --render-script clicks and types its way through every screen (g_render_script), drawing frames
+//            just as the window would. after each step it times --frames full redraws, then writes the frame
+//            to <dump dir>/<step>.ppm and compares it to <golden dir>/<step>.ppm - so a --dump from a known
+//            good build is the golden images for later ones. exits with 1 if any frame differs. the receipt
+//            and stock screens show render_script_inventory.csv, generated in the working directory with a
+//            fixed seed, and deleted again at the end. --timings profiles the frames, and
+//            writes the last FRAME_PROFILE_HISTORY_COUNT of them to <csv> at the end
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include "platform.h"
+#if defined(_WIN32)
+# include "win32_platform.c"
+#else
+# include "posix_platform.c"
+#endif
+#include "gtin8_core.c"
+#include "renderer.c"
+#include "ui.c"
+#include "app.c"
+#include "dataset.c"
+#include "../shared/offscreen.c"
+
+////////////////////////////////
+//~NOTE(tbt): offscreen rendering
+
+static const struct{ const char *name; ProgramMode mode; } g_render_screens[] = {
+    { "menu",        PROGRAM_STATE_MENU },
+    { "check-digit", PROGRAM_STATE_CALCULATE_CHECK_DIGIT },
+    { "verify",      PROGRAM_STATE_VERIFY_CODE },
+    { "receipt",     PROGRAM_STATE_CREATE_RECEIPT },
+    { "stock",       PROGRAM_STATE_CHECK_STOCK },
+};
+
+static bool
+RenderOffscreen(int frames_count,
+                char *screen_name){
+    bool is_success = false;
+
+    Framebuffer framebuffer = {
+        .width = WINDOW_DIMENSIONS_X,
+        .height = WINDOW_DIMENSIONS_Y,
+    };
+    size_t pixels_size = (size_t)framebuffer.width*framebuffer.height*sizeof(Pixel);
+    framebuffer.pixels = PlatformMemoryAllocate(pixels_size);
+
+    int screen_index = -1;
+    for(int i = 0;
+        i < (int)ARRAY_COUNT(g_render_screens);
+        i += 1){
+        if(0 == strcmp(screen_name, g_render_screens[i].name)){
+            screen_index = i;
+        }
+    }
+
+    if(NULL != framebuffer.pixels && screen_index >= 0 && frames_count > 0){
+        AppSetMode(g_render_screens[screen_index].mode);
+
+        uint64_t start = PlatformGetTimeNanoseconds();
+        for(int frame_index = 0;
+            frame_index < frames_count && g_is_running;
+            frame_index += 1){
+            AppUpdateAndRender(&framebuffer);
+        }
+        uint64_t elapsed = PlatformGetTimeNanoseconds() - start;
+
+        printf("screen %s, %d frames, %.3f ms, %.1f us/frame, checksum %016llx\n",
+               screen_name,
+               frames_count,
+               elapsed / 1.0e6,
+               elapsed / 1.0e3 / frames_count,
+               (unsigned long long)Checksum64(framebuffer.pixels, pixels_size));
+        is_success = true;
+    }
+
+    if(NULL != framebuffer.pixels){
+        PlatformMemoryRelease(framebuffer.pixels, pixels_size);
+    }
+    AppShutdown();
+
+    return is_success;
+}
+
+// NOTE(tbt): input for a frame or few. the mouse moves to mouse first, then clicks, scrolls, and types each
+//            character of typed in a frame of its own. frames are drawn until the UI settles before the step
+//            is timed and dumped
+typedef struct RenderScriptStep{
+    const char *name;
+    int mouse[2];
+    bool is_click;
+    int mouse_wheel;
+    const char *typed;
+}RenderScriptStep;
+
+static const RenderScriptStep g_render_script[] = {
+    { "menu",                 { 0, 479 } },
+    { "menu-hover",           { 210, 224 } },
+    { "verify",               { 210, 224 }, .is_click = true },
+    { "verify-typed",         { 380, 200 }, .is_click = true, .typed = "96385074" },
+    { "verify-invalid",       { 380, 200 }, .typed = "\b3" },
+    { "verify-back",          { 6, 6 }, .is_click = true },
+    { "check-digit",          { 210, 200 }, .is_click = true },
+    { "check-digit-typed",    { 380, 200 }, .is_click = true, .typed = "1234567" },
+    { "check-digit-back",     { 6, 6 }, .is_click = true },
+    { "receipt",              { 210, 248 }, .is_click = true },
+    { "receipt-qty",          { 214, 72 }, .is_click = true },
+    { "receipt-back",         { 6, 6 }, .is_click = true },
+    { "stock",                { 210, 272 }, .is_click = true },
+    { "stock-scrolled",       { 300, 200 }, .mouse_wheel = -5 },
+};
+
+static void
+RenderScriptFrame(Framebuffer *framebuffer){
+    AppUpdateAndRender(framebuffer);
+    g_ui_state.mouse_wheel = 0;
+    g_ui_state.char_input = 0;
+}
+
+static bool
+RenderScript(int redraws_count,
+             char *dump_path,
+             char *golden_path,
+             char *timings_path){
+    bool is_success = false;
+    
+    g_frame_profile.is_enabled = (NULL != timings_path);
+    
+    Framebuffer framebuffer = {
+        .width = WINDOW_DIMENSIONS_X,
+        .height = WINDOW_DIMENSIONS_Y,
+    };
+    size_t pixels_size = (size_t)framebuffer.width*framebuffer.height*sizeof(Pixel);
+    framebuffer.pixels = PlatformMemoryAllocate(pixels_size);
+    
+    // NOTE(tbt): the receipt and stock screens show an inventory generated with a fixed seed, rather than
+    //            whatever inventory.csv is lying around, so the frames are the same between runs. it has to
+    //            be more rows than fit on the stock screen, or stock-scrolled wouldn't scroll
+    DatasetParams dataset = {
+        .seed = 1,
+        .items_count = 256,
+    };
+    char *inventory_path = "render_script_inventory.csv";
+    g_inventory_path = inventory_path;
+    
+    if(NULL != framebuffer.pixels && DatasetGenerateInventory(&dataset, inventory_path)){
+        is_success = true;
+        AppSetMode(PROGRAM_STATE_MENU);
+        for(int step_index = 0;
+            step_index < (int)ARRAY_COUNT(g_render_script);
+            step_index += 1){
+            const RenderScriptStep *step = &g_render_script[step_index];
+            
+            g_ui_state.mouse_x = step->mouse[0];
+            g_ui_state.mouse_y = step->mouse[1];
+            RenderScriptFrame(&framebuffer);
+            if(step->is_click){
+                g_ui_state.is_mouse_down = true;
+                RenderScriptFrame(&framebuffer);
+                g_ui_state.is_mouse_down = false;
+                RenderScriptFrame(&framebuffer);
+            }
+            if(0 != step->mouse_wheel){
+                g_ui_state.mouse_wheel = step->mouse_wheel;
+                RenderScriptFrame(&framebuffer);
+            }
+            for(const char *c = step->typed;
+                NULL != c && '\0' != *c;
+                c += 1){
+                g_ui_state.char_input = *c;
+                RenderScriptFrame(&framebuffer);
+            }
+            
+            // NOTE(tbt): e.g. a click which switches screens only shows the new one the frame after
+            for(int settle_index = 0;
+                settle_index < 3;
+                settle_index += 1){
+                RenderScriptFrame(&framebuffer);
+            }
+            
+            uint64_t start = PlatformGetTimeNanoseconds();
+            for(int redraw_index = 0;
+                redraw_index < redraws_count;
+                redraw_index += 1){
+                UIInvalidate();
+                RenderScriptFrame(&framebuffer);
+            }
+            uint64_t elapsed = PlatformGetTimeNanoseconds() - start;
+            
+            printf("step %-20s %9.1f us/redraw, checksum %016llx",
+                   step->name,
+                   (redraws_count > 0) ? elapsed / 1.0e3 / redraws_count : 0.0,
+                   (unsigned long long)Checksum64(framebuffer.pixels, pixels_size));
+            
+            char path[4096];
+            if(NULL != dump_path){
+                snprintf(path, sizeof(path), "%s/%s.ppm", dump_path, step->name);
+                if(!FramebufferWritePPM(&framebuffer, path)){
+                    printf(", couldn't write %s", path);
+                    is_success = false;
+                }
+            }
+            if(NULL != golden_path){
+                snprintf(path, sizeof(path), "%s/%s.ppm", golden_path, step->name);
+                FrameDifference difference;
+                if(FramebufferCompareToPPM(&framebuffer, path, &difference)){
+                    printf(", matches golden");
+                }else if(!difference.is_golden_loaded){
+                    printf(", couldn't read golden %s", path);
+                    is_success = false;
+                }else{
+                    printf(", DIFFERS from golden: %zu pixels (up to %d) in %d,%d - %d,%d",
+                           difference.pixels_count,
+                           difference.max_channel_difference,
+                           difference.bounds.min[0], difference.bounds.min[1],
+                           difference.bounds.max[0], difference.bounds.max[1]);
+                    is_success = false;
+                }
+            }
+            printf("\n");
+        }
+        
+        // NOTE(tbt): the last frame is only recorded when the next one starts
+        if(0 != g_render_frame.previous_timing.frame_index){
+            FrameProfileRecord(&g_render_frame.previous_timing);
+        }
+        if(NULL != timings_path && !FrameProfileWrite(timings_path)){
+            printf("couldn't write %s\n", timings_path);
+            is_success = false;
+        }
+    }
+    
+    if(NULL != framebuffer.pixels){
+        PlatformMemoryRelease(framebuffer.pixels, pixels_size);
+    }
+    AppShutdown();
+    
+    // NOTE(tbt): the snapshot is mapped until the inventory is cleared, and windows won't delete a mapped file
+    InventoryClear(&g_inventory);
+    char snapshot_path[PLATFORM_MAX_PATH];
+    char journal_path[PLATFORM_MAX_PATH];
+    InventorySnapshotPathFromCSVPath(inventory_path, snapshot_path, sizeof(snapshot_path));
+    InventoryJournalPathFromCSVPath(inventory_path, journal_path, sizeof(journal_path));
+    PlatformFileDelete(inventory_path);
+    PlatformFileDelete(snapshot_path);
+    PlatformFileDelete(journal_path);
+    
+    return is_success;
+}
+
+////////////////////////////////
+//~NOTE(tbt): entry point
+
+int
+main(int argc,
+     char **argv){
+    int exit_code = 0;
+    if(argc >= 3 && 0 == strcmp(argv[1], "--render")){
+        if(!RenderOffscreen(atoi(argv[2]), (argc > 3) ? argv[3] : "menu")){
+            exit_code = 1;
+        }
+    }else if(argc >= 2 && 0 == strcmp(argv[1], "--render-script")){
+        int redraws_count = 1;
+        char *dump_path = NULL;
+        char *golden_path = NULL;
+        char *timings_path = NULL;
+        for(int arg_index = 2;
+            arg_index + 1 < argc;
+            arg_index += 2){
+            if(0 == strcmp(argv[arg_index], "--frames")){
+                redraws_count = atoi(argv[arg_index + 1]);
+            }else if(0 == strcmp(argv[arg_index], "--dump")){
+                dump_path = argv[arg_index + 1];
+            }else if(0 == strcmp(argv[arg_index], "--golden")){
+                golden_path = argv[arg_index + 1];
+            }else if(0 == strcmp(argv[arg_index], "--timings")){
+                timings_path = argv[arg_index + 1];
+            }
+        }
+        if(!RenderScript(redraws_count, dump_path, golden_path, timings_path)){
+            exit_code = 1;
+        }
+    }else if(!DatasetRunCommandLine(argc, argv, &exit_code) &&
+             !RunHeadlessCommandLine(argc, argv, &exit_code)){
+        fprintf(stderr,
+                "usage: %s --verify [input] [output]\n"
+                "       %s --generate <start prefix> <end prefix> [output] [--binary]\n"
+                "       %s --render <frames> [menu|check-digit|verify|receipt|stock]\n"
+                "       %s --render-script [--frames <n>] [--dump <dir>] [--golden <dir>] [--timings <csv>]\n"
+                "       %s --dataset <items> <inventory csv> [--sales <count> <sales csv>] [--seed <n>]\n"
+                "           [--duplicates <rate>] [--corrupt <rate>] [--invalid <rate>] [--unknown <rate>]\n",
+                argv[0], argv[0], argv[0], argv[0], argv[0]);
+        exit_code = 1;
+    }
+    return exit_code;
+}
@@ -0,0 +1,167 @@
+////////////////////////////////
+//~NOTE(tbt): platform layer
+//
+//            everything outside of the platform back ends (win32_platform.c and posix_platform.c) and the
+//            window (main.c) goes through this small api rather than talking to the OS directly, so the GTIN-8
+//            core, inventory code, renderer and UI build and run anywhere - including headless on linux.
+//            exactly one back end is included in to each build, after this header.
+
+#if !defined(PLATFORM_H)
+#define PLATFORM_H
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <stdint.h>    // NOTE(tbt): fixed size integers
+#include <stdbool.h>   // NOTE(tbt): bool, true, false
+#include <stddef.h>    // NOTE(tbt): NULL
+#include <stdarg.h>    // NOTE(tbt): va_list
+#include <stdio.h>     // NOTE(tbt): snprintf()
+#include <stdlib.h>    // NOTE(tbt): strtod(), calloc(), free(), qsort()
+#include <ctype.h>     // NOTE(tbt): isprint(), isdigit()
+#include <string.h>    // NOTE(tbt): strcmp
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+# define ARCH_X86 1
+# if defined(_MSC_VER)
+#  include <intrin.h>     // NOTE(tbt): __cpuid(), _xgetbv() and SSE2/AVX2 intrinsics
+# else
+#  include <immintrin.h>  // NOTE(tbt): SSE2/AVX2 intrinsics
+# endif
+#endif
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+// NOTE(tbt): stringify and identifier in the preprocessor - has to be done in two steps due to the order in which the preprocessor expand macros
+#define STRINGIFY_(X) #X
+#define STRINGIFY(X) STRINGIFY_(X)
+#define WSTRINGIFY(X) GLUE(L, STRINGIFY(X))
+
+// NOTE(tbt): join two tokens in the preprocessor - has to be done in two steps due to the order in which the preprocessor expand macros
+#define GLUE_(A, B) A ## B
+#define GLUE(A, B) GLUE_(A, B)
+
+// NOTE(tbt): the number of elements in a static array
+#define ARRAY_COUNT(A) (sizeof(A)/sizeof(A[0]))
+
+// NOTE(tbt): MSVC will happily compile AVX2 intrinsics anywhere, GCC and clang need to be told which
+//            functions are allowed to use them
+#if defined(_MSC_VER)
+# define TARGET_AVX2
+#else
+# define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+enum{
+    PLATFORM_MAX_PATH = 1024, // NOTE(tbt): size of buffers for paths, which are always utf-8
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+// NOTE(tbt): an open file - a HANDLE on windows or a file descriptor on posix
+typedef intptr_t PlatformFile;
+#define PLATFORM_FILE_INVALID ((PlatformFile)-1)
+
+typedef enum PlatformFileMode{
+    PLATFORM_FILE_MODE_READ,   // NOTE(tbt): open an existing file for reading
+    PLATFORM_FILE_MODE_WRITE,  // NOTE(tbt): create or truncate a file for writing
+    PLATFORM_FILE_MODE_APPEND, // NOTE(tbt): open or create a file, with every write going to the end
+}PlatformFileMode;
+
+typedef struct PlatformThread{
+    uintptr_t handle;
+}PlatformThread;
+
+typedef void PlatformThreadProc(void *param);
+
+typedef struct PlatformSemaphore{
+    uintptr_t handle;
+}PlatformSemaphore;
+
+////////////////////////////////
+//~NOTE(tbt): virtual memory
+
+// NOTE(tbt): reserve address space without committing any memory to it. returns NULL on failure
+static void *PlatformMemoryReserve(size_t size);
+
+// NOTE(tbt): commit zeroed, read/write memory to part of a reservation
+static bool PlatformMemoryCommit(void *memory, size_t size);
+
+// NOTE(tbt): release an entire reservation or allocation. size must be what was reserved or allocated
+static void PlatformMemoryRelease(void *memory, size_t size);
+
+// NOTE(tbt): reserve and commit zeroed memory in one go. free with PlatformMemoryRelease()
+static void *PlatformMemoryAllocate(size_t size);
+
+////////////////////////////////
+//~NOTE(tbt): files
+
+static PlatformFile PlatformFileOpen(const char *path, PlatformFileMode mode);
+static PlatformFile PlatformFileStandardInput(void);
+static PlatformFile PlatformFileStandardOutput(void);
+static void PlatformFileClose(PlatformFile file);
+
+// NOTE(tbt): read up to size bytes. *bytes_read is 0 at the end of the file
+static bool PlatformFileRead(PlatformFile file, void *buffer, size_t size, size_t *bytes_read);
+
+// NOTE(tbt): write all of data, however big, at the current position (or the end, for append mode)
+static bool PlatformFileWrite(PlatformFile file, const void *data, size_t size);
+
+// NOTE(tbt): write all of data starting at offset. where the current position ends up is unspecified
+static bool PlatformFileWriteAt(PlatformFile file, uint64_t offset, const void *data, size_t size);
+
+static bool PlatformFileGetSize(PlatformFile file, uint64_t *size);
+
+// NOTE(tbt): the write time is only meaningful compared with other write times from the same platform
+static bool PlatformGetFileSizeAndWriteTime(const char *path, uint64_t *size, uint64_t *write_time);
+
+// NOTE(tbt): rename from over to, atomically replacing to if it exists
+static bool PlatformFileReplace(const char *from, const char *to);
+
+// NOTE(tbt): rename from to to, failing if to already exists
+static bool PlatformFileRename(const char *from, const char *to);
+
+static bool PlatformFileDelete(const char *path);
+
+// NOTE(tbt): map an entire file copy-on-write - writes to the view never reach the file. returns NULL on
+//            failure. unmap with PlatformFileUnmap(), passing the size
+static void *PlatformFileMapCopyOnWrite(const char *path, uint64_t *size);
+static void PlatformFileUnmap(void *view, uint64_t size);
+
+////////////////////////////////
+//~NOTE(tbt): threads
+
+static bool PlatformThreadCreate(PlatformThread *thread, PlatformThreadProc *proc, void *param);
+static void PlatformThreadJoin(PlatformThread thread);
+static int PlatformGetProcessorCount(void);
+
+static bool PlatformSemaphoreCreate(PlatformSemaphore *semaphore, int initial_count);
+static void PlatformSemaphoreSignal(PlatformSemaphore semaphore, int count);
+static void PlatformSemaphoreWait(PlatformSemaphore semaphore);
+static void PlatformSemaphoreDestroy(PlatformSemaphore semaphore);
+
+// NOTE(tbt): add to a value shared between threads, returning what it was before
+static int32_t PlatformAtomicAdd(volatile int32_t *value, int32_t addend);
+
+// NOTE(tbt): wake the main loop to draw a frame. safe to call from any thread, e.g. when a background job has
+//            finished with something which should be shown. does nothing if there is no window
+static void PlatformRequestFrame(void);
+
+////////////////////////////////
+//~NOTE(tbt): time
+
+// NOTE(tbt): monotonic clock for timing things
+static uint64_t PlatformGetTimeNanoseconds(void);
+
+// NOTE(tbt): the wall clock, in 100 nanosecond ticks since 1601 (as a windows FILETIME)
+static uint64_t PlatformGetWallClock(void);
+
+////////////////////////////////
+//~NOTE(tbt): dialogues
+
+// NOTE(tbt): ask the user where to save a file. returns false if they cancel, or there is no one to ask
+static bool PlatformSaveFileDialogue(char *extension, char *buffer, size_t buffer_size);
+
+#endif
@@ -0,0 +1,333 @@
+////////////////////////////////
+//~NOTE(tbt): posix platform back end
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <fcntl.h>     // NOTE(tbt): open()
+#include <unistd.h>    // NOTE(tbt): read(), write(), close(), link(), unlink(), sysconf()
+#include <sys/mman.h>  // NOTE(tbt): mmap(), mprotect(), munmap()
+#include <sys/stat.h>  // NOTE(tbt): fstat(), stat()
+#include <pthread.h>   // NOTE(tbt): pthread_create(), pthread_join()
+#include <semaphore.h> // NOTE(tbt): sem_init(), sem_post(), sem_wait()
+#include <time.h>      // NOTE(tbt): clock_gettime()
+#include <errno.h>     // NOTE(tbt): EINTR
+
+////////////////////////////////
+//~NOTE(tbt): virtual memory
+
+static void *
+PlatformMemoryReserve(size_t size){
+    void *result = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return (MAP_FAILED == result) ? NULL : result;
+}
+
+static bool
+PlatformMemoryCommit(void *memory,
+                     size_t size){
+    return 0 == mprotect(memory, size, PROT_READ | PROT_WRITE);
+}
+
+static void
+PlatformMemoryRelease(void *memory,
+                      size_t size){
+    munmap(memory, size);
+}
+
+static void *
+PlatformMemoryAllocate(size_t size){
+    void *result = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (MAP_FAILED == result) ? NULL : result;
+}
+
+////////////////////////////////
+//~NOTE(tbt): files
+
+static PlatformFile
+PlatformFileOpen(const char *path,
+                 PlatformFileMode mode){
+    int result = -1;
+    if(PLATFORM_FILE_MODE_READ == mode){
+        result = open(path, O_RDONLY | O_CLOEXEC);
+    }else if(PLATFORM_FILE_MODE_WRITE == mode){
+        result = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }else if(PLATFORM_FILE_MODE_APPEND == mode){
+        result = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    }
+    return (PlatformFile)result;
+}
+
+static PlatformFile
+PlatformFileStandardInput(void){
+    return STDIN_FILENO;
+}
+
+static PlatformFile
+PlatformFileStandardOutput(void){
+    return STDOUT_FILENO;
+}
+
+static void
+PlatformFileClose(PlatformFile file){
+    close((int)file);
+}
+
+static bool
+PlatformFileRead(PlatformFile file,
+                 void *buffer,
+                 size_t size,
+                 size_t *bytes_read){
+    ssize_t result;
+    do{
+        result = read((int)file, buffer, (size > (1 << 30)) ? (1 << 30) : size);
+    }while(result < 0 && EINTR == errno);
+    *bytes_read = (result < 0) ? 0 : result;
+    return result >= 0;
+}
+
+static bool
+PlatformFileWrite(PlatformFile file,
+                  const void *data,
+                  size_t size){
+    bool is_success = true;
+    size_t bytes_written = 0;
+    while(is_success && bytes_written < size){
+        ssize_t result = write((int)file, (const char *)data + bytes_written, size - bytes_written);
+        if(result > 0){
+            bytes_written += result;
+        }else if(result < 0 && EINTR == errno){
+            // NOTE(tbt): interrupted before anything was written - try again
+        }else{
+            is_success = false;
+        }
+    }
+    return is_success;
+}
+
+static bool
+PlatformFileWriteAt(PlatformFile file,
+                    uint64_t offset,
+                    const void *data,
+                    size_t size){
+    bool is_success = true;
+    size_t bytes_written = 0;
+    while(is_success && bytes_written < size){
+        ssize_t result = pwrite((int)file, (const char *)data + bytes_written, size - bytes_written, offset + bytes_written);
+        if(result > 0){
+            bytes_written += result;
+        }else if(result < 0 && EINTR == errno){
+            // NOTE(tbt): interrupted before anything was written - try again
+        }else{
+            is_success = false;
+        }
+    }
+    return is_success;
+}
+
+static bool
+PlatformFileGetSize(PlatformFile file,
+                    uint64_t *size){
+    struct stat attributes;
+    bool is_success = (0 == fstat((int)file, &attributes));
+    *size = is_success ? attributes.st_size : 0;
+    return is_success;
+}
+
+// NOTE(tbt): write times are converted to the same 100 nanosecond ticks since 1601 as the wall clock
+static uint64_t
+PosixFileTimeFromTimespec(struct timespec time){
+    return (uint64_t)time.tv_sec*10000000ull + time.tv_nsec/100 + 116444736000000000ull;
+}
+
+static bool
+PlatformGetFileSizeAndWriteTime(const char *path,
+                                uint64_t *size,
+                                uint64_t *write_time){
+    bool result = false;
+    struct stat attributes;
+    if(0 == stat(path, &attributes)){
+        *size = attributes.st_size;
+        *write_time = PosixFileTimeFromTimespec(attributes.st_mtim);
+        result = true;
+    }
+    return result;
+}
+
+static bool
+PlatformFileReplace(const char *from,
+                    const char *to){
+    return 0 == rename(from, to);
+}
+
+// NOTE(tbt): rename() always replaces, so link the new name and then remove the old one. link() fails if the
+//            new name already exists
+static bool
+PlatformFileRename(const char *from,
+                   const char *to){
+    bool result = false;
+    if(0 == link(from, to)){
+        unlink(from);
+        result = true;
+    }
+    return result;
+}
+
+static bool
+PlatformFileDelete(const char *path){
+    return 0 == unlink(path);
+}
+
+static void *
+PlatformFileMapCopyOnWrite(const char *path,
+                           uint64_t *size){
+    void *result = NULL;
+    *size = 0;
+
+    int file = open(path, O_RDONLY | O_CLOEXEC);
+    if(file >= 0){
+        struct stat attributes;
+        if(0 == fstat(file, &attributes) && attributes.st_size > 0){
+            result = mmap(NULL, attributes.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if(MAP_FAILED == result){
+                result = NULL;
+            }else{
+                *size = attributes.st_size;
+            }
+        }
+        close(file);
+    }
+
+    return result;
+}
+
+static void
+PlatformFileUnmap(void *view,
+                  uint64_t size){
+    munmap(view, size);
+}
+
+////////////////////////////////
+//~NOTE(tbt): threads
+
+typedef struct PosixThread{
+    pthread_t thread;
+    PlatformThreadProc *proc;
+    void *param;
+}PosixThread;
+
+static void *
+PosixThreadProc(void *param){
+    PosixThread *thread = param;
+    thread->proc(thread->param);
+    return NULL;
+}
+
+static bool
+PlatformThreadCreate(PlatformThread *thread,
+                     PlatformThreadProc *proc,
+                     void *param){
+    bool is_success = false;
+    PosixThread *posix_thread = malloc(sizeof(*posix_thread));
+    if(NULL != posix_thread){
+        posix_thread->proc = proc;
+        posix_thread->param = param;
+        if(0 == pthread_create(&posix_thread->thread, NULL, PosixThreadProc, posix_thread)){
+            is_success = true;
+        }else{
+            free(posix_thread);
+            posix_thread = NULL;
+        }
+    }
+    thread->handle = (uintptr_t)posix_thread;
+    return is_success;
+}
+
+static void
+PlatformThreadJoin(PlatformThread thread){
+    PosixThread *posix_thread = (PosixThread *)thread.handle;
+    pthread_join(posix_thread->thread, NULL);
+    free(posix_thread);
+}
+
+static int
+PlatformGetProcessorCount(void){
+    long result = sysconf(_SC_NPROCESSORS_ONLN);
+    return (result < 1) ? 1 : (int)result;
+}
+
+static bool
+PlatformSemaphoreCreate(PlatformSemaphore *semaphore,
+                        int initial_count){
+    bool is_success = false;
+    sem_t *posix_semaphore = malloc(sizeof(*posix_semaphore));
+    if(NULL != posix_semaphore){
+        if(0 == sem_init(posix_semaphore, 0, initial_count)){
+            is_success = true;
+        }else{
+            free(posix_semaphore);
+            posix_semaphore = NULL;
+        }
+    }
+    semaphore->handle = (uintptr_t)posix_semaphore;
+    return is_success;
+}
+
+static void
+PlatformSemaphoreSignal(PlatformSemaphore semaphore,
+                        int count){
+    for(int i = 0;
+        i < count;
+        i += 1){
+        sem_post((sem_t *)semaphore.handle);
+    }
+}
+
+static void
+PlatformSemaphoreWait(PlatformSemaphore semaphore){
+    while(0 != sem_wait((sem_t *)semaphore.handle) && EINTR == errno);
+}
+
+static void
+PlatformSemaphoreDestroy(PlatformSemaphore semaphore){
+    sem_destroy((sem_t *)semaphore.handle);
+    free((sem_t *)semaphore.handle);
+}
+
+static int32_t
+PlatformAtomicAdd(volatile int32_t *value,
+                  int32_t addend){
+    return __atomic_fetch_add(value, addend, __ATOMIC_SEQ_CST);
+}
+
+////////////////////////////////
+//~NOTE(tbt): time
+
+static void
+PlatformRequestFrame(void){
+    // NOTE(tbt): the posix build is headless - there is no main loop to wake
+}
+
+static uint64_t
+PlatformGetTimeNanoseconds(void){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec*1000000000ull + time.tv_nsec;
+}
+
+static uint64_t
+PlatformGetWallClock(void){
+    struct timespec time;
+    clock_gettime(CLOCK_REALTIME, &time);
+    return PosixFileTimeFromTimespec(time);
+}
+
+////////////////////////////////
+//~NOTE(tbt): dialogues
+
+// NOTE(tbt): there is no one to ask
+static bool
+PlatformSaveFileDialogue(char *extension,
+                         char *buffer,
+                         size_t buffer_size){
+    return false;
+}
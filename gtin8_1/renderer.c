@@ -0,0 +1,701 @@
+////////////////////////////////
+//~NOTE(tbt): software renderer
+
+// NOTE(tbt): everything is drawn in to a framebuffer in memory, which the platform layer either puts on the
+//            screen (main.c) or keeps offscreen (headless_main.c). the drawing itself is the rasteriser shared
+//            with hangman - this is just the font it draws text with
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    FONT_SIZE = 8,
+};
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+const unsigned char g_font[128][8] =
+{
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0000 (nul)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0001
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0002
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0003
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0004
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0005
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0006
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0007
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0008
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0009
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000A
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000B
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000C
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000D
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000E
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+000F
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0010
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0011
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0012
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0013
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0014
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0015
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0016
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0017
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0018
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0019
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001A
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001B
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001C
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001D
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001E
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+001F
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0020 (space)
+    { 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00 },   // U+0021 (!)
+    { 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0022 (")
+    { 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00 },   // U+0023 (#)
+    { 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00 },   // U+0024 ($)
+    { 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00 },   // U+0025 (%)
+    { 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00 },   // U+0026 (&)
+    { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0027 (')
+    { 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00 },   // U+0028 (()
+    { 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00 },   // U+0029 ())
+    { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 },   // U+002A (*)
+    { 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00 },   // U+002B (+)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06 },   // U+002C (,)
+    { 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00 },   // U+002D (-)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 },   // U+002E (.)
+    { 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00 },   // U+002F (/)
+    { 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00 },   // U+0030 (0)
+    { 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00 },   // U+0031 (1)
+    { 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00 },   // U+0032 (2)
+    { 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00 },   // U+0033 (3)
+    { 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00 },   // U+0034 (4)
+    { 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00 },   // U+0035 (5)
+    { 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00 },   // U+0036 (6)
+    { 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00 },   // U+0037 (7)
+    { 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00 },   // U+0038 (8)
+    { 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00 },   // U+0039 (9)
+    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00 },   // U+003A (:)
+    { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06 },   // U+003B (;)
+    { 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00 },   // U+003C (<)
+    { 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00 },   // U+003D (=)
+    { 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00 },   // U+003E (>)
+    { 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00 },   // U+003F (?)
+    { 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00 },   // U+0040 (@)
+    { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 },   // U+0041 (A)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00 },   // U+0042 (B)
+    { 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00 },   // U+0043 (C)
+    { 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00 },   // U+0044 (D)
+    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00 },   // U+0045 (E)
+    { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00 },   // U+0046 (F)
+    { 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00 },   // U+0047 (G)
+    { 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00 },   // U+0048 (H)
+    { 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0049 (I)
+    { 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00 },   // U+004A (J)
+    { 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00 },   // U+004B (K)
+    { 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00 },   // U+004C (L)
+    { 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00 },   // U+004D (M)
+    { 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00 },   // U+004E (N)
+    { 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00 },   // U+004F (O)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00 },   // U+0050 (P)
+    { 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00 },   // U+0051 (Q)
+    { 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00 },   // U+0052 (R)
+    { 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00 },   // U+0053 (S)
+    { 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0054 (T)
+    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00 },   // U+0055 (U)
+    { 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },   // U+0056 (V)
+    { 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00 },   // U+0057 (W)
+    { 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00 },   // U+0058 (X)
+    { 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0059 (Y)
+    { 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00 },   // U+005A (Z)
+    { 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00 },   // U+005B ([)
+    { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00 },   // U+005C (\)
+    { 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00 },   // U+005D (])
+    { 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 },   // U+005E (^)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF },   // U+005F (_)
+    { 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+0060 (`)
+    { 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00 },   // U+0061 (a)
+    { 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00 },   // U+0062 (b)
+    { 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00 },   // U+0063 (c)
+    { 0x38, 0x30, 0x30, 0x3e, 0x33, 0x33, 0x6E, 0x00 },   // U+0064 (d)
+    { 0x00, 0x00, 0x1E, 0x33, 0x3f, 0x03, 0x1E, 0x00 },   // U+0065 (e)
+    { 0x1C, 0x36, 0x06, 0x0f, 0x06, 0x06, 0x0F, 0x00 },   // U+0066 (f)
+    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F },   // U+0067 (g)
+    { 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00 },   // U+0068 (h)
+    { 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+0069 (i)
+    { 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E },   // U+006A (j)
+    { 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00 },   // U+006B (k)
+    { 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 },   // U+006C (l)
+    { 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00 },   // U+006D (m)
+    { 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00 },   // U+006E (n)
+    { 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00 },   // U+006F (o)
+    { 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F },   // U+0070 (p)
+    { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78 },   // U+0071 (q)
+    { 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00 },   // U+0072 (r)
+    { 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00 },   // U+0073 (s)
+    { 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00 },   // U+0074 (t)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00 },   // U+0075 (u)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 },   // U+0076 (v)
+    { 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00 },   // U+0077 (w)
+    { 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00 },   // U+0078 (x)
+    { 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F },   // U+0079 (y)
+    { 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00 },   // U+007A (z)
+    { 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00 },   // U+007B ({)
+    { 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18 },   // U+007C (|)
+    { 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00 },   // U+007D (})
+    { 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },   // U+007E (~)
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }    // U+007F
+};
+
+////////////////////////////////
+//~NOTE(tbt): drawing
+
+#include "../shared/rasteriser.c"
+
+////////////////////////////////
+//~NOTE(tbt): tiled rendering
+
+// NOTE(tbt): draw work can be recorded in to a render list rather than drawn straight away. a list owns copies
+//            of its strings, so can be drawn after whatever it was recorded from has gone (e.g. on the render
+//            thread, below). executing the
+//            list bins each command in to the RENDER_TILE_SIZE square tiles it touches, then a pool of worker
+//            threads draws the tiles in parallel - each tile running its commands in the order they were
+//            recorded, clipped to the tile. every pixel still sees the same commands in the same order, so
+//            the result is exactly what drawing them one after the other gives. lists covering only a few
+//            pixels aren't worth waking the workers for, so are just drawn in order on the calling thread
+
+enum{
+    RENDER_TILE_SIZE = 64,
+    MAX_RENDER_WORKERS = 15,
+    RENDER_PARALLEL_MIN_PIXELS = 128*1024, // NOTE(tbt): roughly where splitting the work up starts to pay off
+};
+
+typedef enum RenderCommandKind{
+    RENDER_COMMAND_KIND_RECTANGLE_FILL,
+    RENDER_COMMAND_KIND_STRING,
+}RenderCommandKind;
+
+typedef struct RenderCommand{
+    RenderCommandKind kind;
+    Rect clip;          // NOTE(tbt): what the command is allowed to draw to
+    Rect bounds;        // NOTE(tbt): what it might actually touch - always inside clip
+    Pixel colour;
+    Rect rect;          // NOTE(tbt): for fills
+    const char *string; // NOTE(tbt): for strings, copied in to the list's arena
+    int x, y;
+    int scale_factor;
+}RenderCommand;
+
+typedef struct RenderList{
+    Arena arena; // NOTE(tbt): the commands, and the bins while executing. reset each time the list is executed
+    RenderCommand *commands;
+    size_t commands_count;
+    size_t commands_capacity;
+}RenderList;
+
+typedef struct RenderWorkers{
+    bool is_initialised;
+    int workers_count;
+    PlatformThread threads[MAX_RENDER_WORKERS];
+    PlatformSemaphore work_semaphore; // NOTE(tbt): signalled once per worker for each list
+    PlatformSemaphore done_semaphore; // NOTE(tbt): each worker signals once when it runs out of tiles
+    
+    // NOTE(tbt): the list being drawn
+    Framebuffer *framebuffer;
+    RenderList *list;
+    Rect clip;
+    uint32_t *tile_offsets;           // NOTE(tbt): tiles_count + 1 offsets in to tile_command_indices
+    uint32_t *tile_command_indices;   // NOTE(tbt): each tile's commands, in the order they were recorded
+    int tiles_x;
+    int tiles_count;
+    volatile int32_t next_tile;
+}RenderWorkers;
+
+static RenderWorkers g_render_workers; // NOTE(tbt): started the first time a big enough list is executed
+
+static RenderCommand *
+RenderListPush(RenderList *list,
+               RenderCommandKind kind,
+               Rect clip,
+               Rect bounds,
+               Pixel colour){
+    RenderCommand *result = NULL;
+    if(list->commands_count == list->commands_capacity){
+        size_t new_capacity = (0 == list->commands_capacity) ? 256 : 2*list->commands_capacity;
+        RenderCommand *new_commands = ArenaPushNoZero(&list->arena, new_capacity*sizeof(RenderCommand));
+        if(NULL != new_commands){
+            if(list->commands_count > 0){
+                memcpy(new_commands, list->commands, list->commands_count*sizeof(RenderCommand));
+            }
+            list->commands = new_commands;
+            list->commands_capacity = new_capacity;
+        }
+    }
+    if(list->commands_count < list->commands_capacity){
+        result = &list->commands[list->commands_count];
+        list->commands_count += 1;
+        *result = (RenderCommand){ .kind = kind, .clip = clip, .bounds = RectIntersection(bounds, clip), .colour = colour };
+    }
+    return result;
+}
+
+static void
+RenderRectangleFill(RenderList *list,
+                    Rect clip,
+                    Pixel colour,
+                    int min[2],
+                    int max[2]){
+    Rect rect = { { min[0], min[1] }, { max[0], max[1] } };
+    RenderCommand *command = RenderListPush(list, RENDER_COMMAND_KIND_RECTANGLE_FILL, clip, rect, colour);
+    if(NULL != command){
+        command->rect = rect;
+    }
+}
+
+static void
+RenderString(RenderList *list,
+             Rect clip,
+             const char *string,
+             int x, int y,
+             int scale_factor,
+             Pixel colour){
+    Rect bounds;
+    MeasureString(string, x, y, scale_factor, 0, bounds.min, bounds.max);
+    bounds.max[1] += FONT_SIZE << scale_factor; // NOTE(tbt): MeasureString stops at the top of the last line of multi-line text
+    size_t string_size = strlen(string) + 1;
+    char *string_copy = ArenaPushNoZero(&list->arena, string_size);
+    RenderCommand *command = (NULL == string_copy) ? NULL : RenderListPush(list, RENDER_COMMAND_KIND_STRING, clip, bounds, colour);
+    if(NULL != command){
+        memcpy(string_copy, string, string_size);
+        command->string = string_copy;
+        command->x = x;
+        command->y = y;
+        command->scale_factor = scale_factor;
+        GlyphCachePrepare(scale_factor);
+    }
+}
+
+// NOTE(tbt): draw a command, clipped to clip as well as its own clip rect
+static void
+RenderCommandDraw(Framebuffer *framebuffer,
+                  RenderCommand *command,
+                  Rect clip){
+    FramebufferPushClip(framebuffer, RectIntersection(clip, command->clip));
+    switch(command->kind){
+        case(RENDER_COMMAND_KIND_RECTANGLE_FILL):{
+            DrawRectangleFill(framebuffer, command->colour, command->rect.min, command->rect.max);
+        }break;
+        
+        case(RENDER_COMMAND_KIND_STRING):{
+            DrawString(framebuffer, command->string, command->x, command->y, command->scale_factor, command->colour);
+        }break;
+    }
+    FramebufferPopClip(framebuffer);
+}
+
+static void
+RenderWorkersDrawTiles(RenderWorkers *workers){
+    // NOTE(tbt): each thread has its own view of the framebuffer, since the clip stack is in there
+    Framebuffer framebuffer = {
+        .pixels = workers->framebuffer->pixels,
+        .width = workers->framebuffer->width,
+        .height = workers->framebuffer->height,
+    };
+    
+    int tile_index;
+    while((tile_index = PlatformAtomicAdd(&workers->next_tile, 1)) < workers->tiles_count){
+        int tile_x = (tile_index % workers->tiles_x)*RENDER_TILE_SIZE;
+        int tile_y = (tile_index / workers->tiles_x)*RENDER_TILE_SIZE;
+        Rect tile = RectIntersection(workers->clip, (Rect){ { tile_x, tile_y }, { tile_x + RENDER_TILE_SIZE, tile_y + RENDER_TILE_SIZE } });
+        for(uint32_t i = workers->tile_offsets[tile_index];
+            i < workers->tile_offsets[tile_index + 1];
+            i += 1){
+            RenderCommandDraw(&framebuffer, &workers->list->commands[workers->tile_command_indices[i]], tile);
+        }
+    }
+}
+
+static void
+RenderWorkerThreadProc(void *param){
+    RenderWorkers *workers = param;
+    for(;;){
+        PlatformSemaphoreWait(workers->work_semaphore);
+        RenderWorkersDrawTiles(workers);
+        PlatformSemaphoreSignal(workers->done_semaphore, 1);
+    }
+}
+
+// NOTE(tbt): the workers live for the rest of the program, waiting on work_semaphore between lists. the
+//            calling thread draws tiles too, so one fewer is started than there are processors
+static void
+RenderWorkersInitialise(RenderWorkers *workers){
+    workers->is_initialised = true;
+    int workers_count = PlatformGetProcessorCount() - 1;
+    if(workers_count > MAX_RENDER_WORKERS){
+        workers_count = MAX_RENDER_WORKERS;
+    }
+    if(workers_count > 0 &&
+       PlatformSemaphoreCreate(&workers->work_semaphore, 0) &&
+       PlatformSemaphoreCreate(&workers->done_semaphore, 0)){
+        for(int worker_index = 0;
+            worker_index < workers_count;
+            worker_index += 1){
+            if(PlatformThreadCreate(&workers->threads[workers->workers_count], RenderWorkerThreadProc, workers)){
+                workers->workers_count += 1;
+            }
+        }
+    }
+}
+
+static void
+RenderListReset(RenderList *list){
+    ArenaReset(&list->arena);
+    list->commands = NULL;
+    list->commands_count = 0;
+    list->commands_capacity = 0;
+}
+
+// NOTE(tbt): draw every command in order on the calling thread
+static void
+RenderListDraw(RenderList *list,
+               Framebuffer *framebuffer){
+    Rect clip = FramebufferClipRect(framebuffer);
+    for(size_t command_index = 0;
+        command_index < list->commands_count;
+        command_index += 1){
+        RenderCommandDraw(framebuffer, &list->commands[command_index], clip);
+    }
+}
+
+// NOTE(tbt): bin the commands in to tiles and have the workers draw them. returns false if there isn't the
+//            memory for the bins, having drawn nothing
+static bool
+RenderListDrawTiled(RenderList *list,
+                    Framebuffer *framebuffer){
+    bool is_success = false;
+    RenderWorkers *workers = &g_render_workers;
+    Rect clip = FramebufferClipRect(framebuffer);
+    int tiles_x = (framebuffer->width + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE;
+    int tiles_y = (framebuffer->height + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE;
+    int tiles_count = tiles_x*tiles_y;
+    
+    // NOTE(tbt): count each tile's commands, then turn the counts in to offsets and fill the bins in order
+    uint32_t *tile_offsets = ArenaPush(&list->arena, (tiles_count + 1)*sizeof(uint32_t));
+    if(NULL != tile_offsets){
+        size_t bins_size = 0;
+        for(int pass = 0;
+            pass < 2;
+            pass += 1){
+            uint32_t *tile_command_indices = NULL;
+            if(1 == pass){
+                uint32_t offset = 0;
+                for(int tile_index = 0;
+                    tile_index <= tiles_count;
+                    tile_index += 1){
+                    uint32_t count = tile_offsets[tile_index];
+                    tile_offsets[tile_index] = offset;
+                    offset += count;
+                }
+                bins_size = offset;
+                tile_command_indices = ArenaPushNoZero(&list->arena, (bins_size + 1)*sizeof(uint32_t));
+                if(NULL == tile_command_indices){
+                    break;
+                }
+                workers->tile_command_indices = tile_command_indices;
+            }
+            
+            for(size_t command_index = 0;
+                command_index < list->commands_count;
+                command_index += 1){
+                Rect bounds = RectIntersection(list->commands[command_index].bounds, clip);
+                if(!RectIsEmpty(bounds)){
+                    int min_tile_x = bounds.min[0] / RENDER_TILE_SIZE;
+                    int min_tile_y = bounds.min[1] / RENDER_TILE_SIZE;
+                    int max_tile_x = (bounds.max[0] - 1) / RENDER_TILE_SIZE;
+                    int max_tile_y = (bounds.max[1] - 1) / RENDER_TILE_SIZE;
+                    for(int tile_y = min_tile_y;
+                        tile_y <= max_tile_y;
+                        tile_y += 1){
+                        for(int tile_x = min_tile_x;
+                            tile_x <= max_tile_x;
+                            tile_x += 1){
+                            int tile_index = tile_x + tile_y*tiles_x;
+                            if(0 == pass){
+                                tile_offsets[tile_index] += 1;
+                            }else{
+                                tile_command_indices[tile_offsets[tile_index]] = command_index;
+                                tile_offsets[tile_index] += 1;
+                            }
+                        }
+                    }
+                }
+            }
+            
+            if(1 == pass){
+                // NOTE(tbt): filling the bins moved each offset along to the start of the next tile
+                for(int tile_index = tiles_count;
+                    tile_index > 0;
+                    tile_index -= 1){
+                    tile_offsets[tile_index] = tile_offsets[tile_index - 1];
+                }
+                tile_offsets[0] = 0;
+                is_success = true;
+            }
+        }
+    }
+    
+    if(is_success){
+        workers->framebuffer = framebuffer;
+        workers->list = list;
+        workers->clip = clip;
+        workers->tile_offsets = tile_offsets;
+        workers->tiles_x = tiles_x;
+        workers->tiles_count = tiles_count;
+        workers->next_tile = 0;
+        
+        PlatformSemaphoreSignal(workers->work_semaphore, workers->workers_count);
+        RenderWorkersDrawTiles(workers);
+        for(int worker_index = 0;
+            worker_index < workers->workers_count;
+            worker_index += 1){
+            PlatformSemaphoreWait(workers->done_semaphore);
+        }
+    }
+    
+    return is_success;
+}
+
+// NOTE(tbt): draw everything recorded in the list, then empty it
+static void
+RenderListExecute(RenderList *list,
+                  Framebuffer *framebuffer){
+    if(!g_render_workers.is_initialised){
+        RenderWorkersInitialise(&g_render_workers);
+    }
+    
+    int64_t pixels_count = 0;
+    for(size_t command_index = 0;
+        command_index < list->commands_count;
+        command_index += 1){
+        Rect bounds = list->commands[command_index].bounds;
+        if(!RectIsEmpty(bounds)){
+            pixels_count += (int64_t)(bounds.max[0] - bounds.min[0])*(bounds.max[1] - bounds.min[1]);
+        }
+    }
+    
+    if(g_render_workers.workers_count == 0 ||
+       pixels_count < RENDER_PARALLEL_MIN_PIXELS ||
+       !RenderListDrawTiled(list, framebuffer)){
+        RenderListDraw(list, framebuffer);
+    }
+    
+    RenderListReset(list);
+}
+
+////////////////////////////////
+//~NOTE(tbt): render thread
+
+// NOTE(tbt): lets the next frame be built while the last one is still being drawn and presented. whoever builds
+//            frames (the UI, on the main thread) records each in to one of two RenderFrames and submits it;
+//            the render thread executes it in to one of two framebuffers and hands that to present(). the
+//            other framebuffer is left alone meanwhile - it has what was last presented
+//
+//            the UI only redraws what changed since the frame before, but the back buffer is two frames old,
+//            so before drawing a frame the render thread first copies across what the previous one damaged
+
+enum{
+    MAX_RENDER_FRAME_DAMAGE_RECTS = 32,
+};
+
+// NOTE(tbt): how long each part of a frame took, and how much it did. frame_index is 0 unless whoever built
+//            the frame wants it timed, in which case the renderer fills in rasterise_ns and present_ns
+typedef struct FrameTiming{
+    uint64_t frame_index;
+    uint64_t build_ns;      // NOTE(tbt): building the UI, and recording what it draws
+    uint64_t rasterise_ns;  // NOTE(tbt): executing the render list, including bringing the back buffer up to date
+    uint64_t present_ns;    // NOTE(tbt): handing the pixels to the window
+    uint32_t widgets_count;
+    uint32_t commands_count;
+    uint64_t pixels_count;  // NOTE(tbt): the area of the damage
+}FrameTiming;
+
+// NOTE(tbt): one frame's drawing, and the parts of the framebuffer it changes
+typedef struct RenderFrame{
+    RenderList list;
+    int width;
+    int height;
+    Rect damage[MAX_RENDER_FRAME_DAMAGE_RECTS];
+    size_t damage_count;
+    FrameTiming timing;
+    FrameTiming previous_timing; // NOTE(tbt): of the last frame drawn from this RenderFrame, once it has been presented
+}RenderFrame;
+
+typedef void RenderPresentFunction(void *param, Framebuffer *framebuffer, Rect *damage, size_t damage_count);
+
+typedef struct RenderPipeline{
+    Framebuffer framebuffers[2];
+    RenderFrame frames[2];
+    RenderPresentFunction *present;
+    void *present_param;
+    
+    bool is_threaded;               // NOTE(tbt): false if the render thread isn't worth it or couldn't be started - frames are then
+                                    //            drawn and presented as they are submitted, on the calling thread
+    bool is_stopping;               // NOTE(tbt): tells the render thread to exit, next time it wakes
+    PlatformThread thread;
+    PlatformSemaphore frames_ready; // NOTE(tbt): submitted frames waiting for the render thread
+    PlatformSemaphore frames_free;  // NOTE(tbt): frames the UI can build in to
+    
+    uint64_t frames_begun_count;    // NOTE(tbt): only touched by the thread building frames
+    uint64_t frames_drawn_count;    // NOTE(tbt): only touched by the render thread
+    Rect previous_damage[MAX_RENDER_FRAME_DAMAGE_RECTS];
+    size_t previous_damage_count;
+}RenderPipeline;
+
+// NOTE(tbt): copy a rect of pixels between two framebuffers of the same size
+static void
+FramebufferCopyRect(Framebuffer *destination,
+                    Framebuffer *source,
+                    Rect rect){
+    rect = RectIntersection(rect, (Rect){ .max = { destination->width, destination->height } });
+    if(!RectIsEmpty(rect)){
+        size_t row_size = (rect.max[0] - rect.min[0])*sizeof(Pixel);
+        for(int y = rect.min[1];
+            y < rect.max[1];
+            y += 1){
+            size_t offset = (size_t)y*destination->width + rect.min[0];
+            memcpy(&destination->pixels[offset], &source->pixels[offset], row_size);
+        }
+    }
+}
+
+static void
+RenderPipelineDrawFrame(RenderPipeline *pipeline){
+    uint64_t frame_index = pipeline->frames_drawn_count;
+    RenderFrame *frame = &pipeline->frames[frame_index & 1];
+    Framebuffer *back = &pipeline->framebuffers[frame_index & 1];
+    Framebuffer *front = &pipeline->framebuffers[(frame_index + 1) & 1];
+    if(!pipeline->is_threaded){
+        // NOTE(tbt): nothing else can be looking at the framebuffer, so there's no need to alternate
+        back = &pipeline->framebuffers[0];
+    }
+    
+    bool is_timed = (0 != frame->timing.frame_index);
+    uint64_t rasterise_start = is_timed ? PlatformGetTimeNanoseconds() : 0;
+    
+    if(pipeline->is_threaded && frame_index > 0){
+        for(size_t damage_index = 0;
+            damage_index < pipeline->previous_damage_count;
+            damage_index += 1){
+            // NOTE(tbt): no need to copy what this frame redraws anyway
+            Rect stale = pipeline->previous_damage[damage_index];
+            bool is_redrawn = false;
+            for(size_t redrawn_index = 0;
+                redrawn_index < frame->damage_count && !is_redrawn;
+                redrawn_index += 1){
+                Rect redrawn = frame->damage[redrawn_index];
+                is_redrawn = (stale.min[0] >= redrawn.min[0] && stale.min[1] >= redrawn.min[1] &&
+                              stale.max[0] <= redrawn.max[0] && stale.max[1] <= redrawn.max[1]);
+            }
+            if(!is_redrawn){
+                FramebufferCopyRect(back, front, stale);
+            }
+        }
+    }
+    RenderListExecute(&frame->list, back);
+    uint64_t present_start = is_timed ? PlatformGetTimeNanoseconds() : 0;
+    pipeline->present(pipeline->present_param, back, frame->damage, frame->damage_count);
+    if(is_timed){
+        uint64_t present_end = PlatformGetTimeNanoseconds();
+        frame->timing.rasterise_ns = present_start - rasterise_start;
+        frame->timing.present_ns = present_end - present_start;
+    }
+    
+    memcpy(pipeline->previous_damage, frame->damage, frame->damage_count*sizeof(Rect));
+    pipeline->previous_damage_count = frame->damage_count;
+    pipeline->frames_drawn_count += 1;
+}
+
+static void
+RenderPipelineThreadProc(void *param){
+    RenderPipeline *pipeline = param;
+    PlatformSemaphoreWait(pipeline->frames_ready);
+    while(!pipeline->is_stopping){
+        RenderPipelineDrawFrame(pipeline);
+        PlatformSemaphoreSignal(pipeline->frames_free, 1);
+        PlatformSemaphoreWait(pipeline->frames_ready);
+    }
+}
+
+// NOTE(tbt): the framebuffers must be the same size, and stay valid for as long as the pipeline is used. with
+//            only one processor there is nothing to overlap, so the thread would just add hand-offs
+static void
+RenderPipelineStart(RenderPipeline *pipeline,
+                    Framebuffer framebuffers[2],
+                    RenderPresentFunction *present,
+                    void *present_param){
+    pipeline->framebuffers[0] = framebuffers[0];
+    pipeline->framebuffers[1] = framebuffers[1];
+    pipeline->present = present;
+    pipeline->present_param = present_param;
+    pipeline->is_threaded = (PlatformGetProcessorCount() > 1 &&
+                             PlatformSemaphoreCreate(&pipeline->frames_ready, 0) &&
+                             PlatformSemaphoreCreate(&pipeline->frames_free, 2) &&
+                             PlatformThreadCreate(&pipeline->thread, RenderPipelineThreadProc, pipeline));
+}
+
+// NOTE(tbt): waits for a free frame, if both are still being drawn, and empties it ready to record in to
+static RenderFrame *
+RenderPipelineBeginFrame(RenderPipeline *pipeline){
+    if(pipeline->is_threaded){
+        PlatformSemaphoreWait(pipeline->frames_free);
+    }
+    RenderFrame *frame = &pipeline->frames[pipeline->frames_begun_count & 1];
+    RenderListReset(&frame->list);
+    frame->width = pipeline->framebuffers[0].width;
+    frame->height = pipeline->framebuffers[0].height;
+    frame->damage_count = 0;
+    frame->previous_timing = frame->timing;
+    frame->timing = (FrameTiming){ 0 };
+    return frame;
+}
+
+static void
+RenderPipelineSubmitFrame(RenderPipeline *pipeline){
+    pipeline->frames_begun_count += 1;
+    if(pipeline->is_threaded){
+        PlatformSemaphoreSignal(pipeline->frames_ready, 1);
+    }else{
+        RenderPipelineDrawFrame(pipeline);
+    }
+}
+
+// NOTE(tbt): wait until everything submitted has been presented
+static void
+RenderPipelineFlush(RenderPipeline *pipeline){
+    if(pipeline->is_threaded){
+        PlatformSemaphoreWait(pipeline->frames_free);
+        PlatformSemaphoreWait(pipeline->frames_free);
+        PlatformSemaphoreSignal(pipeline->frames_free, 2);
+    }
+}
+
+// NOTE(tbt): present everything submitted, then end the render thread and release the frames. the pipeline
+//            can be started again afterwards, but forgets which parts of the framebuffers are stale, so the
+//            first frame after that should redraw everything
+static void
+RenderPipelineStop(RenderPipeline *pipeline){
+    if(pipeline->is_threaded){
+        RenderPipelineFlush(pipeline);
+        pipeline->is_stopping = true;
+        PlatformSemaphoreSignal(pipeline->frames_ready, 1);
+        PlatformThreadJoin(pipeline->thread);
+        PlatformSemaphoreDestroy(pipeline->frames_ready);
+        PlatformSemaphoreDestroy(pipeline->frames_free);
+    }
+    for(int frame_index = 0;
+        frame_index < 2;
+        frame_index += 1){
+        ArenaRelease(&pipeline->frames[frame_index].list.arena);
+    }
+    memset(pipeline, 0, sizeof(*pipeline));
+}
@@ -0,0 +1,758 @@
+////////////////////////////////
+//~NOTE(tbt): immediate mode UI
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    MAX_UI_WIDGET_TEXT = 512,
+    MAX_UI_FG_COL_STACK = 256,
+    UI_MIN_WIDGET_TABLE_SIZE = 256, // NOTE(tbt): must be a power of 2
+    
+    UI_FONT_SCALE = 1,
+    UI_PADDING = 2,
+    UI_ROW_HEIGHT = FONT_SIZE << UI_FONT_SCALE,
+    UI_SCROLLBAR_WIDTH = 10,
+    UI_ROWS_PER_WHEEL_NOTCH = 3,
+    MAX_UI_DAMAGE_RECTS = MAX_RENDER_FRAME_DAMAGE_RECTS,
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef uint32_t UIWidgetFlags;
+typedef enum UIWidgetFlags{
+    UI_WIDGET_FLAGS_CLICKABLE             = (1 << 0), // NOTE(tbt): active on mouse down
+    UI_WIDGET_FLAGS_TOGGLEABLE            = (1 << 1), // NOTE(tbt): toggle when active
+    UI_WIDGET_FLAGS_DETOGGLE_ON_ANY_CLICK = (1 << 3), // NOTE(tbt): becomes untoglled on any mouse click outside
+}UIWidgetFlags_ENUM;
+
+// NOTE(tbt): widgets live in a pool which never moves, so pointers to them stay valid from frame to frame.
+//            text is stored out of line - for most widgets it is copied in to a per-frame arena, and only
+//            line edits, whose text is their state, get a persistent buffer
+typedef struct UIWidget{
+    uint64_t id;
+    UIWidgetFlags flags;
+    char *text;
+    uint64_t text_hash;    // NOTE(tbt): HashString() of text
+    char *edit_buffer;     // NOTE(tbt): MAX_UI_WIDGET_TEXT bytes, allocated the first time the slot is used for a line edit
+    int min[2];
+    int max[2];
+    bool is_clicked;
+    bool is_toggled;
+    Pixel fg_col;
+    Pixel bg_col;
+    size_t scroll_row;     // NOTE(tbt): the first visible row, for lists
+    
+    // NOTE(tbt): the extents of text drawn at 0, 0 - MeasureString() with no padding. measured once and kept
+    //            for as long as the text stays the same
+    uint64_t layout_text_hash;
+    Rect layout_extents;
+    
+    // NOTE(tbt): what the widget looked like in the framebuffer as of drawn_frame, to tell when it needs redrawing
+    uint64_t drawn_frame;
+    uint64_t drawn_signature;
+    Rect drawn_bounds;
+    
+    uint64_t last_frame;   // NOTE(tbt): the last frame the widget was submitted in
+    uint32_t next_free;    // NOTE(tbt): 1 + the index of the next free widget in the pool, while this one is free
+}UIWidget;
+
+// NOTE(tbt): an open addressing table from widget ids to their index in the pool. 0 is never a valid id, so
+//            marks an empty slot
+typedef struct UIWidgetTableSlot{
+    uint64_t id;
+    uint32_t widget_index;
+}UIWidgetTableSlot;
+
+// NOTE(tbt): the rows of a list to submit this frame - [first_row, end_row), the first of which is at x, y
+typedef struct UIListRows{
+    size_t first_row;
+    size_t end_row;
+    int x;
+    int y;
+}UIListRows;
+
+typedef struct UIState{
+    Arena widgets_arena;         // NOTE(tbt): the pool of UIWidgets
+    uint32_t widgets_pool_count; // NOTE(tbt): used and free widgets in the pool
+    uint32_t first_free;         // NOTE(tbt): 1 + the index of the first free widget, or 0 for none
+    UIWidgetTableSlot *table;
+    size_t table_size;
+    size_t table_count;
+    
+    uint64_t frame_index;
+    Arena frame_arenas[2];       // NOTE(tbt): widget text and the submitted lists, alternating so last frame's survives
+    UIWidget **submitted;        // NOTE(tbt): this frame's widgets, in the order they are drawn
+    size_t widgets_count;
+    size_t submitted_capacity;
+    UIWidget **previous_submitted;
+    size_t previous_widgets_count;
+    
+    // NOTE(tbt): the framebuffer is kept from one frame to the next, and only the parts of it which have changed
+    //            are redrawn - and then presented by the platform layer
+    Rect damage[MAX_UI_DAMAGE_RECTS];
+    size_t damage_count;
+    bool is_invalidated;
+    int framebuffer_width;
+    int framebuffer_height;
+    
+    Arena edit_buffers_arena;
+    
+
+    UIWidget *hot;
+    UIWidget *active;
+    
+    bool is_mouse_down;
+    int mouse_x;
+    int mouse_y;
+    int mouse_wheel; // NOTE(tbt): notches scrolled this frame, positive away from the user
+    char char_input;
+    
+    Pixel fg_col_stack[MAX_UI_FG_COL_STACK];
+    size_t fg_col_stack_count;
+}UIState;
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+static UIState g_ui_state = {0};
+
+////////////////////////////////
+//~NOTE(tbt): widgets
+
+// NOTE(tbt): 64 bit FNV-1a of a string, for widget ids. never 0, which marks an empty table slot
+static uint64_t
+HashString(char *string){
+    uint64_t result = 0xcbf29ce484222325ull;
+    while(*string){
+        result ^= (unsigned char)*string;
+        result *= 0x100000001b3ull;
+        string += 1;
+    }
+    return (0 == result) ? 1 : result;
+}
+
+// NOTE(tbt): the widget's text measured as if drawn at x, y, the same as MeasureString(). layout doesn't depend
+//            on where the text is, so it is only actually measured when the text changes, and just moved to x, y
+static Rect
+UIWidgetMeasureText(UIWidget *widget,
+                    int x, int y,
+                    int padding){
+    if(widget->layout_text_hash != widget->text_hash){
+        MeasureString(widget->text, 0, 0, UI_FONT_SCALE, 0, widget->layout_extents.min, widget->layout_extents.max);
+        widget->layout_text_hash = widget->text_hash;
+    }
+    Rect result = {
+        { x + widget->layout_extents.min[0] - padding, y + widget->layout_extents.min[1] - padding },
+        { x + widget->layout_extents.max[0] + padding, y + widget->layout_extents.max[1] + padding },
+    };
+    return result;
+}
+
+// NOTE(tbt): hit test a widget
+static bool
+UIWidgetHasPoint(UIWidget *widget,
+                 int x, int y){
+    if(x >= widget->min[0] &&
+       x <= widget->max[0] &&
+       y >= widget->min[1] &&
+       y <= widget->max[1]){
+        return true;
+    }else{
+        return false;
+    }
+}
+
+static void
+UIPushColour(Pixel colour){
+    if(g_ui_state.fg_col_stack_count < MAX_UI_FG_COL_STACK - 1){
+        g_ui_state.fg_col_stack_count += 1;
+        g_ui_state.fg_col_stack[g_ui_state.fg_col_stack_count] = colour;
+    }
+}
+
+static void
+UIPopColour(){
+    if(g_ui_state.fg_col_stack_count > 0){
+        g_ui_state.fg_col_stack_count -= 1;
+    }
+}
+
+static Arena *
+UIFrameArena(void){
+    return &g_ui_state.frame_arenas[g_ui_state.frame_index & 1];
+}
+
+static void
+UIPrepare(void){
+    g_ui_state.hot = NULL;
+    g_ui_state.previous_submitted = g_ui_state.submitted;
+    g_ui_state.previous_widgets_count = g_ui_state.widgets_count;
+    g_ui_state.frame_index += 1;
+    ArenaReset(UIFrameArena());
+    g_ui_state.submitted = NULL;
+    g_ui_state.widgets_count = 0;
+    g_ui_state.submitted_capacity = 0;
+    g_ui_state.fg_col_stack[0] = (Pixel){ 255, 255, 255 };
+}
+
+// NOTE(tbt): redraw everything next frame, e.g. if the framebuffer has been drawn over
+static void
+UIInvalidate(void){
+    g_ui_state.is_invalidated = true;
+}
+
+// NOTE(tbt): add a rect to the damage, merging it with anything it overlaps. if there are too many rects,
+//            they all get merged in to one
+static void
+UIDamage(Rect rect){
+    rect = RectIntersection(rect, (Rect){ .max = { g_ui_state.framebuffer_width, g_ui_state.framebuffer_height } });
+    if(!RectIsEmpty(rect)){
+        for(size_t damage_index = 0;
+            damage_index < g_ui_state.damage_count;){
+            if(!RectIsEmpty(RectIntersection(rect, g_ui_state.damage[damage_index]))){
+                rect = RectUnion(rect, g_ui_state.damage[damage_index]);
+                g_ui_state.damage_count -= 1;
+                g_ui_state.damage[damage_index] = g_ui_state.damage[g_ui_state.damage_count];
+                damage_index = 0;
+            }else{
+                damage_index += 1;
+            }
+        }
+        if(g_ui_state.damage_count == MAX_UI_DAMAGE_RECTS){
+            for(size_t damage_index = 1;
+                damage_index < g_ui_state.damage_count;
+                damage_index += 1){
+                g_ui_state.damage[0] = RectUnion(g_ui_state.damage[0], g_ui_state.damage[damage_index]);
+            }
+            g_ui_state.damage[0] = RectUnion(g_ui_state.damage[0], rect);
+            g_ui_state.damage_count = 1;
+        }else{
+            g_ui_state.damage[g_ui_state.damage_count] = rect;
+            g_ui_state.damage_count += 1;
+        }
+    }
+}
+
+// NOTE(tbt): the background colour and horizontal offset a widget is drawn with, from its state
+static void
+UIWidgetGetAppearance(UIWidget *widget,
+                      Pixel *bg_col,
+                      int *x_offset){
+    *bg_col = widget->bg_col;
+    *x_offset = 0;
+    if(widget->is_toggled){
+        *bg_col = (Pixel){ 45, 45, 100 };
+        *x_offset += UI_PADDING;
+    }else if(widget == g_ui_state.active){
+        *bg_col = (Pixel){ 100, 45, 45 };
+    }else if(widget == g_ui_state.hot){
+        *bg_col = (Pixel){ 150, 30, 30 };
+    }
+}
+
+static void
+UIWidgetDraw(RenderList *list,
+             Rect clip,
+             UIWidget *widget){
+    Pixel bg_col;
+    int x_offset;
+    UIWidgetGetAppearance(widget, &bg_col, &x_offset);
+    int min[2] = { widget->min[0] + x_offset, widget->min[1] };
+    int max[2] = { widget->max[0] + x_offset, widget->max[1] };
+    RenderRectangleFill(list, clip, bg_col, min, max);
+    RenderString(list, clip, widget->text, widget->min[0] + UI_PADDING + x_offset, widget->min[1] + UI_PADDING, UI_FONT_SCALE, widget->fg_col);
+}
+
+// NOTE(tbt): work out what has changed since last frame, then clear and redraw only that. a widget's
+//            signature covers everything it is drawn from, so if that and its bounds are the same as last
+//            frame the pixels are too. anything else - a changed widget, a new one, or one which has gone -
+//            damages where it was and where it is now. every widget overlapping the damage is redrawn,
+//            clipped to it, in the order they were submitted. nothing is drawn here - the redraw and the
+//            damage are recorded in to frame, for the renderer to draw whenever and wherever it likes
+static void
+UIFinish(RenderFrame *frame){
+    if(!g_ui_state.is_mouse_down){
+        g_ui_state.active = NULL;
+    }
+    g_ui_state.char_input = 0;
+    g_ui_state.mouse_wheel = 0;
+    
+    g_ui_state.damage_count = 0;
+    if(g_ui_state.is_invalidated ||
+       frame->width != g_ui_state.framebuffer_width ||
+       frame->height != g_ui_state.framebuffer_height){
+        g_ui_state.framebuffer_width = frame->width;
+        g_ui_state.framebuffer_height = frame->height;
+        g_ui_state.is_invalidated = false;
+        UIDamage((Rect){ .max = { frame->width, frame->height } });
+    }
+    
+    for(size_t widget_index = 0;
+        widget_index < g_ui_state.previous_widgets_count;
+        widget_index += 1){
+        UIWidget *widget = g_ui_state.previous_submitted[widget_index];
+        if(widget->last_frame != g_ui_state.frame_index &&
+           widget->drawn_frame + 1 == g_ui_state.frame_index){
+            UIDamage(widget->drawn_bounds);
+            widget->drawn_frame = 0;
+        }
+    }
+    
+    for(size_t widget_index = 0;
+        widget_index < g_ui_state.widgets_count;
+        widget_index += 1){
+        UIWidget *widget = g_ui_state.submitted[widget_index];
+        Pixel bg_col;
+        int x_offset;
+        UIWidgetGetAppearance(widget, &bg_col, &x_offset);
+        
+        Rect bounds = { { widget->min[0] + x_offset, widget->min[1] }, { widget->max[0] + x_offset, widget->max[1] } };
+        Rect text_bounds = UIWidgetMeasureText(widget, widget->min[0] + UI_PADDING + x_offset, widget->min[1] + UI_PADDING, 0);
+        text_bounds.max[1] += UI_ROW_HEIGHT; // NOTE(tbt): MeasureString stops at the top of the last line of multi-line text
+        bounds = RectUnion(bounds, text_bounds);
+        
+        uint64_t signature = widget->text_hash;
+        struct{ Pixel fg_col; Pixel bg_col; int min[2]; int max[2]; int x_offset; }appearance = {
+            widget->fg_col, bg_col, { widget->min[0], widget->min[1] }, { widget->max[0], widget->max[1] }, x_offset,
+        };
+        signature ^= Checksum64(&appearance, sizeof(appearance))*0x9e3779b97f4a7c15ull;
+        
+        bool is_drawn = (widget->drawn_frame + 1 == g_ui_state.frame_index);
+        if(!is_drawn ||
+           signature != widget->drawn_signature ||
+           0 != memcmp(&bounds, &widget->drawn_bounds, sizeof(bounds))){
+            if(is_drawn){
+                UIDamage(widget->drawn_bounds);
+            }
+            UIDamage(bounds);
+        }
+        widget->drawn_frame = g_ui_state.frame_index;
+        widget->drawn_signature = signature;
+        widget->drawn_bounds = bounds;
+    }
+    
+    RenderList *list = &frame->list;
+    for(size_t damage_index = 0;
+        damage_index < g_ui_state.damage_count;
+        damage_index += 1){
+        Rect damage = g_ui_state.damage[damage_index];
+        RenderRectangleFill(list, damage, (Pixel){ 0 }, damage.min, damage.max);
+        for(size_t widget_index = 0;
+            widget_index < g_ui_state.widgets_count;
+            widget_index += 1){
+            UIWidget *widget = g_ui_state.submitted[widget_index];
+            if(!RectIsEmpty(RectIntersection(widget->drawn_bounds, damage))){
+                UIWidgetDraw(list, damage, widget);
+            }
+        }
+    }
+    memcpy(frame->damage, g_ui_state.damage, g_ui_state.damage_count*sizeof(Rect));
+    frame->damage_count = g_ui_state.damage_count;
+}
+
+static UIWidget *
+UIWidgetFromIndex(uint32_t widget_index){
+    return &((UIWidget *)g_ui_state.widgets_arena.base)[widget_index];
+}
+
+// NOTE(tbt): linear probing. returns the slot with id, or the empty slot where it would go
+static UIWidgetTableSlot *
+UIWidgetTableLookup(UIWidgetTableSlot *table,
+                    size_t table_size,
+                    uint64_t id){
+    size_t mask = table_size - 1;
+    size_t slot_index = id & mask;
+    while(0 != table[slot_index].id && id != table[slot_index].id){
+        slot_index = (slot_index + 1) & mask;
+    }
+    return &table[slot_index];
+}
+
+// NOTE(tbt): called when the table gets half full. rather than sweeping every frame, widgets which weren't
+//            submitted last frame or this one are only given back to the pool here, and the table is rebuilt
+//            from what is left - doubling in size if it would still be over a quarter full
+static void
+UIWidgetTableRebuild(void){
+    size_t live_count = 0;
+    for(size_t slot_index = 0;
+        slot_index < g_ui_state.table_size;
+        slot_index += 1){
+        UIWidgetTableSlot *slot = &g_ui_state.table[slot_index];
+        if(0 != slot->id){
+            UIWidget *widget = UIWidgetFromIndex(slot->widget_index);
+            if(widget->last_frame + 1 >= g_ui_state.frame_index ||
+               widget == g_ui_state.active){
+                live_count += 1;
+            }
+        }
+    }
+    
+    size_t new_size = (0 == g_ui_state.table_size) ? UI_MIN_WIDGET_TABLE_SIZE : g_ui_state.table_size;
+    while((live_count + 1)*4 > new_size){
+        new_size *= 2;
+    }
+    
+    UIWidgetTableSlot *new_table = PlatformMemoryAllocate(new_size*sizeof(new_table[0]));
+    if(NULL != new_table){
+        for(size_t slot_index = 0;
+            slot_index < g_ui_state.table_size;
+            slot_index += 1){
+            UIWidgetTableSlot *slot = &g_ui_state.table[slot_index];
+            if(0 != slot->id){
+                UIWidget *widget = UIWidgetFromIndex(slot->widget_index);
+                if(widget->last_frame + 1 >= g_ui_state.frame_index ||
+                   widget == g_ui_state.active){
+                    *UIWidgetTableLookup(new_table, new_size, slot->id) = *slot;
+                }else{
+                    widget->id = 0;
+                    widget->next_free = g_ui_state.first_free;
+                    g_ui_state.first_free = slot->widget_index + 1;
+                }
+            }
+        }
+        if(NULL != g_ui_state.table){
+            PlatformMemoryRelease(g_ui_state.table, g_ui_state.table_size*sizeof(g_ui_state.table[0]));
+        }
+        g_ui_state.table = new_table;
+        g_ui_state.table_size = new_size;
+        g_ui_state.table_count = live_count;
+    }
+}
+
+// NOTE(tbt): a widget from the pool, off the free list if there is anything on it. NULL if out of memory
+static UIWidget *
+UIWidgetAllocate(uint32_t *widget_index){
+    UIWidget *result = NULL;
+    if(0 != g_ui_state.first_free){
+        *widget_index = g_ui_state.first_free - 1;
+        result = UIWidgetFromIndex(*widget_index);
+        g_ui_state.first_free = result->next_free;
+    }else{
+        result = ArenaPush(&g_ui_state.widgets_arena, sizeof(UIWidget));
+        if(NULL != result){
+            *widget_index = g_ui_state.widgets_pool_count;
+            g_ui_state.widgets_pool_count += 1;
+        }
+    }
+    return result;
+}
+
+// NOTE(tbt): the submitted list lives in the frame arena, doubling in to a new block when it fills
+static void
+UISubmitWidget(UIWidget *widget){
+    if(g_ui_state.widgets_count == g_ui_state.submitted_capacity){
+        size_t new_capacity = (0 == g_ui_state.submitted_capacity) ? 64 : g_ui_state.submitted_capacity*2;
+        UIWidget **new_submitted = ArenaPushNoZero(UIFrameArena(), new_capacity*sizeof(new_submitted[0]));
+        if(NULL != new_submitted){
+            if(g_ui_state.widgets_count > 0){
+                memcpy(new_submitted, g_ui_state.submitted, g_ui_state.widgets_count*sizeof(new_submitted[0]));
+            }
+            g_ui_state.submitted = new_submitted;
+            g_ui_state.submitted_capacity = new_capacity;
+        }
+    }
+    if(g_ui_state.widgets_count < g_ui_state.submitted_capacity){
+        g_ui_state.submitted[g_ui_state.widgets_count] = widget;
+        g_ui_state.widgets_count += 1;
+    }
+}
+
+// NOTE(tbt): copy text in to the frame arena for the widget to draw. text_hash is HashString(text), which
+//            callers usually already have as the widget's id
+static void
+UIWidgetSetText(UIWidget *widget,
+                char *text,
+                uint64_t text_hash){
+    size_t length = strlen(text);
+    if(length > MAX_UI_WIDGET_TEXT - 1){
+        length = MAX_UI_WIDGET_TEXT - 1;
+    }
+    char *copy = ArenaPushNoZero(UIFrameArena(), length + 1);
+    if(NULL != copy){
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+        widget->text = copy;
+        widget->text_hash = (text[length] == '\0') ? text_hash : HashString(copy);
+    }
+}
+
+// NOTE(tbt): back to a new widget, keeping the edit buffer (emptied) if it has one. what it last drew is kept
+//            too, since that is still in the framebuffer
+static void
+UIWidgetReset(UIWidget *widget,
+              uint64_t id,
+              UIWidgetFlags flags){
+    char *edit_buffer = widget->edit_buffer;
+    uint64_t drawn_frame = widget->drawn_frame;
+    uint64_t drawn_signature = widget->drawn_signature;
+    Rect drawn_bounds = widget->drawn_bounds;
+    memset(widget, 0, sizeof(*widget));
+    widget->id = id;
+    widget->flags = flags;
+    widget->edit_buffer = edit_buffer;
+    widget->drawn_frame = drawn_frame;
+    widget->drawn_signature = drawn_signature;
+    widget->drawn_bounds = drawn_bounds;
+    if(NULL != edit_buffer){
+        edit_buffer[0] = '\0';
+    }
+}
+
+// NOTE(tbt): widgets are found by the full 64 bit hash of str_id, so different strings only share state if
+//            their hashes collide. a widget which wasn't submitted last frame, or whose flags have changed,
+//            starts again from scratch
+static UIWidget *
+UIPushWidget(char *str_id,
+             UIWidgetFlags flags){
+    static UIWidget fallback = {0}; // NOTE(tbt): handed out if the pool can't grow, so callers needn't check
+    
+    uint64_t id = HashString(str_id);
+    
+    if((g_ui_state.table_count + 1)*2 > g_ui_state.table_size){
+        UIWidgetTableRebuild();
+    }
+    
+    UIWidget *result = NULL;
+    UIWidgetTableSlot *slot = NULL;
+    if(NULL != g_ui_state.table){
+        slot = UIWidgetTableLookup(g_ui_state.table, g_ui_state.table_size, id);
+    }
+    if(NULL != slot && 0 != slot->id){
+        result = UIWidgetFromIndex(slot->widget_index);
+        if(result->last_frame != g_ui_state.frame_index &&
+           (result->flags != flags || result->last_frame + 1 < g_ui_state.frame_index)){
+            UIWidgetReset(result, id, flags);
+        }
+    }else if(NULL != slot && (g_ui_state.table_count + 1)*2 <= g_ui_state.table_size){
+        uint32_t widget_index;
+        result = UIWidgetAllocate(&widget_index);
+        if(NULL != result){
+            slot->id = id;
+            slot->widget_index = widget_index;
+            g_ui_state.table_count += 1;
+            UIWidgetReset(result, id, flags);
+        }
+    }
+    if(NULL == result){
+        result = &fallback;
+        UIWidgetReset(result, id, flags);
+    }
+    
+    if(result->last_frame != g_ui_state.frame_index || result == &fallback){
+        result->text = "";
+        result->text_hash = HashString("");
+        result->last_frame = g_ui_state.frame_index;
+        UISubmitWidget(result);
+    }
+    result->fg_col = g_ui_state.fg_col_stack[g_ui_state.fg_col_stack_count];
+    result->bg_col = (Pixel){ 200, 15, 15 };
+    return result;
+}
+
+static void
+UIDoWidget(UIWidget *widget){
+    if(UIWidgetHasPoint(widget, g_ui_state.mouse_x, g_ui_state.mouse_y)){
+        g_ui_state.hot = widget;
+        if((widget->flags & UI_WIDGET_FLAGS_CLICKABLE) &&
+           g_ui_state.is_mouse_down){
+            g_ui_state.active = widget;
+        }
+    }else if((widget->flags & UI_WIDGET_FLAGS_DETOGGLE_ON_ANY_CLICK) &&
+             g_ui_state.is_mouse_down){
+        widget->is_toggled = false;
+    }
+    
+    if(widget->flags & UI_WIDGET_FLAGS_CLICKABLE){
+        if(g_ui_state.hot == widget &&
+           g_ui_state.active == widget &&
+           !g_ui_state.is_mouse_down){
+            widget->is_clicked = true;
+        }else{
+            widget->is_clicked = false;
+        }
+    }
+    
+    if((widget->flags & UI_WIDGET_FLAGS_TOGGLEABLE) &&
+       widget->is_clicked){
+        widget->is_toggled = !widget->is_toggled;
+    }
+}
+
+// NOTE(tbt): a filled rectangle, drawn in order with the other widgets
+static void
+UIRectangle(char *str_id,
+            Pixel colour,
+            int min[2],
+            int max[2]){
+    UIWidget *widget = UIPushWidget(str_id, 0);
+    widget->bg_col = colour;
+    widget->min[0] = min[0];
+    widget->min[1] = min[1];
+    widget->max[0] = max[0];
+    widget->max[1] = max[1];
+}
+
+static void
+UILabel(char *text, int x, int y){
+    UIWidget *widget = UIPushWidget(text, 0);
+    UIWidgetSetText(widget, text, widget->id);
+    widget->min[0] = widget->max[0] = x;
+    widget->min[1] = widget->max[1] = y;
+    UIDoWidget(widget);
+}
+
+static void
+UILabelF(int x, int y, char *fmt, ...){
+    char text[MAX_UI_WIDGET_TEXT];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text) - 1, fmt, args);
+    va_end(args);
+    UIWidget *widget = UIPushWidget(text, 0);
+    UIWidgetSetText(widget, text, widget->id);
+    widget->min[0] = widget->max[0] = x;
+    widget->min[1] = widget->max[1] = y;
+    UIDoWidget(widget);
+}
+
+static bool
+UIButton(char *text, int x, int y){
+    UIWidget *widget = UIPushWidget(text, UI_WIDGET_FLAGS_CLICKABLE);
+    UIWidgetSetText(widget, text, widget->id);
+    Rect bounds = UIWidgetMeasureText(widget, x, y, UI_PADDING);
+    memcpy(widget->min, bounds.min, sizeof(widget->min));
+    memcpy(widget->max, bounds.max, sizeof(widget->max));
+    UIDoWidget(widget);
+    return widget->is_clicked;
+}
+
+static bool
+UIToggleButton(char *text, int x, int y){
+    UIWidget *widget = UIPushWidget(text,
+                                    UI_WIDGET_FLAGS_CLICKABLE |
+                                    UI_WIDGET_FLAGS_TOGGLEABLE);
+    UIWidgetSetText(widget, text, widget->id);
+    Rect bounds = UIWidgetMeasureText(widget, x, y, UI_PADDING);
+    memcpy(widget->min, bounds.min, sizeof(widget->min));
+    memcpy(widget->max, bounds.max, sizeof(widget->max));
+    UIDoWidget(widget);
+    return widget->is_toggled;
+}
+
+static char *
+UILineEdit(char *str_id,
+           int x, int y,
+           int max_characters){
+    max_characters += 1; // NOTE(tbt): allow for NULL terminator
+    
+    if(max_characters > MAX_UI_WIDGET_TEXT){
+        max_characters = MAX_UI_WIDGET_TEXT;
+    }
+    
+    UIWidget *widget = UIPushWidget(str_id,
+                                    UI_WIDGET_FLAGS_CLICKABLE |
+                                    UI_WIDGET_FLAGS_TOGGLEABLE |
+                                    UI_WIDGET_FLAGS_DETOGGLE_ON_ANY_CLICK);
+    widget->min[0] = x - UI_PADDING;
+    widget->min[1] = y - UI_PADDING;
+    widget->max[0] = x + UI_PADDING + (max_characters - 1)*(FONT_SIZE << UI_FONT_SCALE);
+    widget->max[1] = y + UI_PADDING + (FONT_SIZE << UI_FONT_SCALE);
+    if(NULL == widget->edit_buffer){
+        widget->edit_buffer = ArenaPush(&g_ui_state.edit_buffers_arena, MAX_UI_WIDGET_TEXT);
+    }
+    if(NULL == widget->edit_buffer){
+        static char fallback[MAX_UI_WIDGET_TEXT];
+        fallback[0] = '\0';
+        widget->edit_buffer = fallback;
+    }
+    widget->text = widget->edit_buffer;
+    UIDoWidget(widget);
+    if(widget->is_toggled && g_ui_state.char_input){
+        char c = g_ui_state.char_input;
+        size_t len = strlen(widget->text);
+        if(g_ui_state.char_input == 8 && len > 0){
+            widget->text[len - 1] = '\0';
+        }else if(isprint(c) && len < max_characters - 1){
+            widget->text[len] = c;
+            widget->text[len + 1] ='\0';
+        }
+    }
+    widget->text_hash = HashString(widget->text);
+    return widget->text;
+}
+
+// NOTE(tbt): a scrolling list of rows_count rows, UI_ROW_HEIGHT apart, filling min to max. only the rows
+//            which fit are returned, so the caller only formats and submits those - the cost of a frame doesn't
+//            depend on how long the list is. scrolls with the mouse wheel while hovered, or by dragging the
+//            scrollbar, which is only there if the rows don't all fit
+static UIListRows
+UIList(char *str_id,
+       int min[2],
+       int max[2],
+       size_t rows_count){
+    UIListRows result = {0};
+    
+    size_t visible_rows_count = (max[1] - min[1]) / UI_ROW_HEIGHT;
+    size_t max_scroll_row = (rows_count > visible_rows_count) ? rows_count - visible_rows_count : 0;
+    
+    UIWidget *widget = UIPushWidget(str_id, UI_WIDGET_FLAGS_CLICKABLE);
+    widget->min[0] = max[0] - UI_SCROLLBAR_WIDTH;
+    widget->min[1] = min[1];
+    widget->max[0] = max[0];
+    widget->max[1] = max[1];
+    if(0 == max_scroll_row){
+        // NOTE(tbt): nothing to scroll, so no scrollbar
+        widget->min[0] = widget->max[0] = max[0];
+        widget->max[1] = min[1];
+    }
+    UIDoWidget(widget);
+    
+    if(g_ui_state.mouse_x >= min[0] && g_ui_state.mouse_x <= max[0] &&
+       g_ui_state.mouse_y >= min[1] && g_ui_state.mouse_y <= max[1]){
+        int rows_delta = -g_ui_state.mouse_wheel*UI_ROWS_PER_WHEEL_NOTCH;
+        if(rows_delta < 0 && (size_t)-rows_delta > widget->scroll_row){
+            widget->scroll_row = 0;
+        }else{
+            widget->scroll_row += rows_delta;
+        }
+    }
+    if(g_ui_state.active == widget && max[1] > min[1]){
+        int track_y = g_ui_state.mouse_y - min[1];
+        if(track_y < 0){
+            track_y = 0;
+        }
+        widget->scroll_row = (size_t)track_y*(max_scroll_row + 1) / (max[1] - min[1]);
+    }
+    if(widget->scroll_row > max_scroll_row){
+        widget->scroll_row = max_scroll_row;
+    }
+    
+    if(max_scroll_row > 0){
+        // NOTE(tbt): the thumb is sized and placed to show which part of the list is visible
+        char thumb_id[MAX_UI_WIDGET_TEXT];
+        snprintf(thumb_id, sizeof(thumb_id), "%s##thumb", str_id);
+        UIWidget *thumb = UIPushWidget(thumb_id, 0);
+        thumb->bg_col = (Pixel){ 235, 235, 235 };
+        int track_height = max[1] - min[1];
+        int thumb_height = (int)((uint64_t)track_height*visible_rows_count / rows_count);
+        if(thumb_height < UI_SCROLLBAR_WIDTH){
+            thumb_height = UI_SCROLLBAR_WIDTH;
+        }
+        thumb->min[0] = widget->min[0] + UI_PADDING;
+        thumb->max[0] = widget->max[0] - UI_PADDING;
+        thumb->min[1] = min[1] + (int)((uint64_t)(track_height - thumb_height)*widget->scroll_row / max_scroll_row);
+        thumb->max[1] = thumb->min[1] + thumb_height;
+    }
+    
+    result.first_row = widget->scroll_row;
+    result.end_row = result.first_row + visible_rows_count;
+    if(result.end_row > rows_count){
+        result.end_row = rows_count;
+    }
+    result.x = min[0];
+    result.y = min[1];
+    
+    return result;
+}
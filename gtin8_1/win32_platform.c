@@ -0,0 +1,392 @@
+////////////////////////////////
+//~NOTE(tbt): win32 platform back end
+
+// NOTE(tbt): paths are utf-8 everywhere outside of this file, and converted to utf-16 for the W functions
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <windows.h>   // NOTE(tbt): windows system headers
+#include <commdlg.h>   // NOTE(tbt): GetSaveFileNameW()
+
+////////////////////////////////
+//~NOTE(tbt): libraries
+
+#pragma comment(lib, "kernel32.lib") // NOTE(tbt): files, memory, threads and time
+#pragma comment(lib, "comdlg32.lib") // NOTE(tbt): GetSaveFileNameW()
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+static HWND g_window_handle;              // NOTE(tbt): owner of dialogues - NULL until there is a window
+static HANDLE g_frame_request_event;      // NOTE(tbt): the main loop waits on this - NULL until there is a window
+
+////////////////////////////////
+//~NOTE(tbt): utf-8 conversion
+
+// NOTE(tbt): returns false if string doesn't fit in the buffer, or isn't valid utf-8
+static bool
+Win32WideFromUTF8(const char *string,
+                  wchar_t *buffer,
+                  int buffer_count){
+    return 0 != MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, string, -1, buffer, buffer_count);
+}
+
+static bool
+Win32UTF8FromWide(const wchar_t *string,
+                  char *buffer,
+                  int buffer_size){
+    return 0 != WideCharToMultiByte(CP_UTF8, 0, string, -1, buffer, buffer_size, NULL, NULL);
+}
+
+////////////////////////////////
+//~NOTE(tbt): virtual memory
+
+static void *
+PlatformMemoryReserve(size_t size){
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static bool
+PlatformMemoryCommit(void *memory,
+                     size_t size){
+    return NULL != VirtualAlloc(memory, size, MEM_COMMIT, PAGE_READWRITE);
+}
+
+static void
+PlatformMemoryRelease(void *memory,
+                      size_t size){
+    VirtualFree(memory, 0, MEM_RELEASE);
+}
+
+static void *
+PlatformMemoryAllocate(size_t size){
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+////////////////////////////////
+//~NOTE(tbt): files
+
+static PlatformFile
+PlatformFileOpen(const char *path,
+                 PlatformFileMode mode){
+    HANDLE result = INVALID_HANDLE_VALUE;
+    wchar_t path_w[PLATFORM_MAX_PATH];
+    if(Win32WideFromUTF8(path, path_w, ARRAY_COUNT(path_w))){
+        if(PLATFORM_FILE_MODE_READ == mode){
+            result = CreateFileW(path_w, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        }else if(PLATFORM_FILE_MODE_WRITE == mode){
+            result = CreateFileW(path_w, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+        }else if(PLATFORM_FILE_MODE_APPEND == mode){
+            result = CreateFileW(path_w, FILE_APPEND_DATA, 0, 0, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+        }
+    }
+    return (PlatformFile)result;
+}
+
+static PlatformFile
+Win32FileFromStandardHandle(DWORD std_handle){
+    HANDLE result = GetStdHandle(std_handle);
+    if(NULL == result){
+        result = INVALID_HANDLE_VALUE;
+    }
+    return (PlatformFile)result;
+}
+
+static PlatformFile
+PlatformFileStandardInput(void){
+    return Win32FileFromStandardHandle(STD_INPUT_HANDLE);
+}
+
+static PlatformFile
+PlatformFileStandardOutput(void){
+    return Win32FileFromStandardHandle(STD_OUTPUT_HANDLE);
+}
+
+static void
+PlatformFileClose(PlatformFile file){
+    CloseHandle((HANDLE)file);
+}
+
+// NOTE(tbt): ReadFile() and WriteFile() can only move a DWORD's worth of bytes at a time
+static bool
+PlatformFileRead(PlatformFile file,
+                 void *buffer,
+                 size_t size,
+                 size_t *bytes_read){
+    DWORD n_bytes_to_read = (size > (1 << 30)) ? (1 << 30) : (DWORD)size;
+    DWORD n_bytes_read = 0;
+    bool is_success = ReadFile((HANDLE)file, buffer, n_bytes_to_read, &n_bytes_read, NULL);
+    *bytes_read = n_bytes_read;
+    return is_success;
+}
+
+static bool
+PlatformFileWrite(PlatformFile file,
+                  const void *data,
+                  size_t size){
+    bool is_success = true;
+    size_t bytes_written = 0;
+    while(is_success && bytes_written < size){
+        DWORD n_bytes_to_write = (size - bytes_written > (1 << 30)) ? (1 << 30) : (DWORD)(size - bytes_written);
+        DWORD n_bytes_written = 0;
+        if(!WriteFile((HANDLE)file, (const char *)data + bytes_written, n_bytes_to_write, &n_bytes_written, NULL) ||
+           0 == n_bytes_written){
+            is_success = false;
+        }
+        bytes_written += n_bytes_written;
+    }
+    return is_success;
+}
+
+static bool
+PlatformFileWriteAt(PlatformFile file,
+                    uint64_t offset,
+                    const void *data,
+                    size_t size){
+    LARGE_INTEGER position = { .QuadPart = offset };
+    return (SetFilePointerEx((HANDLE)file, position, NULL, FILE_BEGIN) &&
+            PlatformFileWrite(file, data, size));
+}
+
+static bool
+PlatformFileGetSize(PlatformFile file,
+                    uint64_t *size){
+    LARGE_INTEGER result;
+    bool is_success = GetFileSizeEx((HANDLE)file, &result);
+    *size = is_success ? result.QuadPart : 0;
+    return is_success;
+}
+
+static bool
+PlatformGetFileSizeAndWriteTime(const char *path,
+                                uint64_t *size,
+                                uint64_t *write_time){
+    bool result = false;
+    wchar_t path_w[PLATFORM_MAX_PATH];
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if(Win32WideFromUTF8(path, path_w, ARRAY_COUNT(path_w)) &&
+       GetFileAttributesExW(path_w, GetFileExInfoStandard, &attributes)){
+        *size = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+        *write_time = ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+        result = true;
+    }
+    return result;
+}
+
+static bool
+Win32MoveFile(const char *from,
+              const char *to,
+              DWORD flags){
+    wchar_t from_w[PLATFORM_MAX_PATH];
+    wchar_t to_w[PLATFORM_MAX_PATH];
+    return (Win32WideFromUTF8(from, from_w, ARRAY_COUNT(from_w)) &&
+            Win32WideFromUTF8(to, to_w, ARRAY_COUNT(to_w)) &&
+            MoveFileExW(from_w, to_w, flags));
+}
+
+static bool
+PlatformFileReplace(const char *from,
+                    const char *to){
+    return Win32MoveFile(from, to, MOVEFILE_REPLACE_EXISTING);
+}
+
+static bool
+PlatformFileRename(const char *from,
+                   const char *to){
+    return Win32MoveFile(from, to, 0);
+}
+
+static bool
+PlatformFileDelete(const char *path){
+    wchar_t path_w[PLATFORM_MAX_PATH];
+    return (Win32WideFromUTF8(path, path_w, ARRAY_COUNT(path_w)) &&
+            DeleteFileW(path_w));
+}
+
+static void *
+PlatformFileMapCopyOnWrite(const char *path,
+                           uint64_t *size){
+    void *result = NULL;
+    *size = 0;
+
+    wchar_t path_w[PLATFORM_MAX_PATH];
+    HANDLE file_handle = INVALID_HANDLE_VALUE;
+    if(Win32WideFromUTF8(path, path_w, ARRAY_COUNT(path_w))){
+        file_handle = CreateFileW(path_w, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    }
+    HANDLE mapping_handle = NULL;
+    uint64_t file_size = 0;
+    if(INVALID_HANDLE_VALUE != file_handle){
+        // NOTE(tbt): an empty file can't be mapped
+        if(PlatformFileGetSize((PlatformFile)file_handle, &file_size) && file_size > 0){
+            mapping_handle = CreateFileMappingW(file_handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        }
+        CloseHandle(file_handle);
+    }
+    if(NULL != mapping_handle){
+        result = MapViewOfFile(mapping_handle, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping_handle);
+    }
+    if(NULL != result){
+        *size = file_size;
+    }
+
+    return result;
+}
+
+static void
+PlatformFileUnmap(void *view,
+                  uint64_t size){
+    UnmapViewOfFile(view);
+}
+
+////////////////////////////////
+//~NOTE(tbt): threads
+
+typedef struct Win32ThreadStart{
+    PlatformThreadProc *proc;
+    void *param;
+}Win32ThreadStart;
+
+static DWORD WINAPI
+Win32ThreadProc(void *param){
+    Win32ThreadStart start = *(Win32ThreadStart *)param;
+    free(param);
+    start.proc(start.param);
+    return 0;
+}
+
+static bool
+PlatformThreadCreate(PlatformThread *thread,
+                     PlatformThreadProc *proc,
+                     void *param){
+    HANDLE thread_handle = NULL;
+    Win32ThreadStart *start = malloc(sizeof(*start));
+    if(NULL != start){
+        *start = (Win32ThreadStart){ proc, param };
+        thread_handle = CreateThread(NULL, 0, Win32ThreadProc, start, 0, NULL);
+        if(NULL == thread_handle){
+            free(start);
+        }
+    }
+    thread->handle = (uintptr_t)thread_handle;
+    return NULL != thread_handle;
+}
+
+static void
+PlatformThreadJoin(PlatformThread thread){
+    WaitForSingleObject((HANDLE)thread.handle, INFINITE);
+    CloseHandle((HANDLE)thread.handle);
+}
+
+static int
+PlatformGetProcessorCount(void){
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwNumberOfProcessors;
+}
+
+static bool
+PlatformSemaphoreCreate(PlatformSemaphore *semaphore,
+                        int initial_count){
+    HANDLE semaphore_handle = CreateSemaphoreW(NULL, initial_count, 0x7fffffff, NULL);
+    semaphore->handle = (uintptr_t)semaphore_handle;
+    return NULL != semaphore_handle;
+}
+
+static void
+PlatformSemaphoreSignal(PlatformSemaphore semaphore,
+                        int count){
+    ReleaseSemaphore((HANDLE)semaphore.handle, count, NULL);
+}
+
+static void
+PlatformSemaphoreWait(PlatformSemaphore semaphore){
+    WaitForSingleObject((HANDLE)semaphore.handle, INFINITE);
+}
+
+static void
+PlatformSemaphoreDestroy(PlatformSemaphore semaphore){
+    CloseHandle((HANDLE)semaphore.handle);
+}
+
+static int32_t
+PlatformAtomicAdd(volatile int32_t *value,
+                  int32_t addend){
+    return InterlockedExchangeAdd((volatile LONG *)value, addend);
+}
+
+static void
+PlatformRequestFrame(void){
+    if(NULL != g_frame_request_event){
+        SetEvent(g_frame_request_event);
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): time
+
+static uint64_t
+PlatformGetTimeNanoseconds(void){
+    static uint64_t frequency = 0;
+    if(0 == frequency){
+        LARGE_INTEGER result;
+        QueryPerformanceFrequency(&result);
+        frequency = result.QuadPart;
+    }
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    // NOTE(tbt): split in to whole seconds and the remainder so the multiply can't overflow
+    uint64_t seconds = counter.QuadPart / frequency;
+    uint64_t remainder = counter.QuadPart % frequency;
+    return seconds*1000000000ull + remainder*1000000000ull / frequency;
+}
+
+static uint64_t
+PlatformGetWallClock(void){
+    FILETIME time;
+    GetSystemTimeAsFileTime(&time);
+    return ((uint64_t)time.dwHighDateTime << 32) | time.dwLowDateTime;
+}
+
+////////////////////////////////
+//~NOTE(tbt): dialogues
+
+static bool
+PlatformSaveFileDialogue(char *extension,
+                         char *buffer,
+                         size_t buffer_size){
+    bool result = false;
+
+    wchar_t extension_w[16];
+    if(Win32WideFromUTF8(extension, extension_w, ARRAY_COUNT(extension_w))){
+        wchar_t filters[256];
+        {
+            int extension_index = swprintf(filters, ARRAY_COUNT(filters), L"%ls files (*.%ls)", extension_w, extension_w) + 1;
+            swprintf(filters + extension_index, ARRAY_COUNT(filters) - extension_index, L"*.%ls", extension_w);
+            filters[extension_index + wcslen(filters + extension_index) + 1] = L'\0';
+        }
+
+        wchar_t file[PLATFORM_MAX_PATH] = {0};
+        OPENFILENAMEW open_file_name =
+        {
+            .lStructSize = sizeof(open_file_name),
+            .hwndOwner = g_window_handle,
+            .lpstrFilter = filters,
+            .lpstrFile = file,
+            .nMaxFile = ARRAY_COUNT(file),
+            .lpstrInitialDir = NULL,
+            .lpstrTitle = L"save",
+            .Flags = 0,
+            .lpstrDefExt = extension_w,
+        };
+
+        if(GetSaveFileNameW(&open_file_name)){
+            result = Win32UTF8FromWide(file, buffer, buffer_size);
+        }
+    }
+
+    return result;
+}
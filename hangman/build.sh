@@ -0,0 +1,6 @@
+#!/bin/sh
+
+# NOTE(tbt): the headless build, for anywhere without a window system (e.g. linux)
+
+cd "$(dirname "$0")"
+${CC:-cc} -std=gnu11 -O2 -g headless_main.c resources.c -o headless_hangman
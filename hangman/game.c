@@ -0,0 +1,207 @@
+////////////////////////////////
+//~NOTE(tbt): game
+
+// NOTE(tbt): the game itself, with nothing windows specific - so it can run in a window (main.c) or
+//            offscreen (headless_main.c). whoever includes this must include resources.h and
+//            ../shared/rasteriser.c first, and seed g_random_seed
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef struct GenericImage{
+    int width;       // NOTE(tbt): width of the image in pixels
+    int height;      // NOTE(tbt): height of the image in pixels
+    Pixel pixels[0]; // NOTE(tbt): pixel data follows rest of struct
+} GenericImage;
+
+////////////////////////////////
+//~NOTE(tbt): macros and constants
+
+// NOTE(tbt): fixed size window to make my life a bit easier
+enum WindowDimensions{
+    WINDOW_DIMENSIONS_X = 640,
+    WINDOW_DIMENSIONS_Y = 480,
+};
+
+// NOTE(tbt): keep track of which state the game is in
+typedef enum GameState{
+    GAME_STATE_PLAYING,
+    GAME_STATE_WON,
+    GAME_STATE_LOST,
+} GameState;
+
+// NOTE(tbt): the number of elements in a static array
+#define ARRAY_COUNT(A) (sizeof(A)/sizeof(A[0]))
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+static GameState g_game_state = GAME_STATE_PLAYING;
+
+static GenericImage *g_hangman_art[] = {                               // NOTE(tbt): frames of artwork for each number of lives left
+    &life_10,
+    &life_9,
+    &life_8,
+    &life_7,
+    &life_6,
+    &life_5,
+    &life_4,
+    &life_3,
+    &life_2,
+    &life_1,
+};
+static int g_lives_left = ARRAY_COUNT(g_hangman_art);                  // NOTE(tbt): number of lives left
+
+static const char *g_word_to_guess = NULL;                             // NOTE(tbt): the selected word to guess
+static char g_guessed_word[4096];                                      // NOTE(tbt): the word as guessed so far, with un-guessed letters replaced with _
+static char g_guessed_letters[4096];                                   // NOTE(tbt): an array of all letters which have been guessed alread
+static int g_guessed_letters_count = 0;                                // NOTE(tbt): the number of used elements in the guessed letters array
+
+static unsigned int g_random_seed = 0;                                 // NOTE(tbt): the next position in the pseudo random sequence words are picked with
+
+static Pixel g_window_pixels[WINDOW_DIMENSIONS_X*WINDOW_DIMENSIONS_Y]; // NOTE(tbt): array of pixels representing the window
+
+// NOTE(tbt): the window pixels, for the rasteriser to draw in to
+static Framebuffer g_framebuffer = {
+    .pixels = g_window_pixels,
+    .width = WINDOW_DIMENSIONS_X,
+    .height = WINDOW_DIMENSIONS_Y,
+};
+
+////////////////////////////////
+//~NOTE(tbt): gameplay
+
+// NOTE(tbt): compute a hash of an integer, useful for generating a pseudorandom sequence
+static unsigned int
+HashInt(unsigned int i){
+    int result = i;
+    result = ((result >> 16) ^ result)*0x45d9f3b;
+    result = ((result >> 16) ^ result)*0x45d9f3b;
+    result = ((result >> 16) ^ result);
+    return result;
+}
+
+// NOTE(tbt): retrieve the next integer in a pseudo random sequence
+static int
+RandIntNext(void){
+    int result = HashInt(g_random_seed);
+    g_random_seed += 1;
+    return result;
+}
+
+// NOTE(tbt): reset gameplay global variable to defaut values, e.g. start a new game
+static void
+ResetGame(void){
+    g_word_to_guess = NULL;
+    g_guessed_letters_count = 0;
+    g_lives_left = ARRAY_COUNT(g_hangman_art);
+    strncpy(g_guessed_word, "type a letter to\nguess", ARRAY_COUNT(g_guessed_word) - 1);
+    g_game_state = GAME_STATE_PLAYING;
+}
+
+// NOTE(tbt): returns true if the guess changed anything, so the screen needs redrawing
+static bool
+GuessLetter(char letter){
+    bool result = false;
+    
+    // NOTE(tbt): check to see if the letter has already been guessed
+    bool is_letter_guessed = false;
+    for(int guessed_letter_index = 0;
+        guessed_letter_index < g_guessed_letters_count;
+        guessed_letter_index += 1){
+        if(g_guessed_letters[guessed_letter_index] == letter){
+            is_letter_guessed = true;
+            break;
+        }
+    }
+    
+    // NOTE(tbt): ignore already guessed letters
+    if(!is_letter_guessed){
+        // NOTE(tbt): insert guessed letter into guessed letters array
+        g_guessed_letters[g_guessed_letters_count] = letter;
+        g_guessed_letters_count += 1;
+        
+        // NOTE(tbt): select a random word if neccessary
+        if(NULL == g_word_to_guess){
+            g_word_to_guess = g_words[RandIntNext() % ARRAY_COUNT(g_words)];
+        }
+        
+        // NOTE(tbt): make a copy of the word
+        int word_len = strlen(g_word_to_guess);
+        memcpy(g_guessed_word, g_word_to_guess, word_len);
+        g_guessed_word[word_len] = '\0';
+        
+        bool is_word_guessed_correctly = true;
+        bool is_guessed_letter_in_word = false;
+        
+        // NOTE(tbt): loop through each letter
+        for(int char_index = 0;
+            char_index < word_len;
+            char_index += 1){
+            // NOTE(tbt): check if the guessed letter is correct
+            if(g_word_to_guess[char_index] == letter){
+                is_guessed_letter_in_word = true;
+            }
+            // NOTE(tbt): check if the current letter of the word has already been guessed
+            bool is_letter_guessed = false;
+            for(int guessed_letter_index = 0;
+                guessed_letter_index < g_guessed_letters_count;
+                guessed_letter_index += 1){
+                if(g_guessed_word[char_index] == g_guessed_letters[guessed_letter_index]){
+                    is_letter_guessed = true;
+                    break;
+                }
+            }
+            // NOTE(tbt): replace letters that have not yet been guessed with underscores
+            if(!is_letter_guessed){
+                // NOTE(tbt): keep track of whether the entire word has been guessed
+                is_word_guessed_correctly = false;
+                g_guessed_word[char_index] = '_';
+            }
+        }
+        
+        if(is_word_guessed_correctly){
+            // NOTE(tbt): win the game if the entire word was guessed
+            g_game_state = GAME_STATE_WON;
+        }else if(!is_guessed_letter_in_word){
+            // NOTE(tbt): decrease lives if the guess was incorrect
+            g_lives_left -= 1;
+            if(g_lives_left == 0){
+                // NOTE(tbt): loose if there are no lives left
+                g_game_state = GAME_STATE_LOST;
+            }
+        }
+        
+        result = true;
+    }
+    
+    return result;
+}
+
+// NOTE(tbt): draw the whole game in to the window pixels
+static void
+DrawGame(Framebuffer *framebuffer){
+    if(g_lives_left >= ARRAY_COUNT(g_hangman_art)){
+        // NOTE(tbt): clear the screen with white if all lives are remaining
+        FramebufferFill(framebuffer, (Pixel){ 255, 255, 255, 255 });
+    }else{
+        // NOTE(tbt): otherwise lookup and draw the appropriate artwork
+        GenericImage *image = g_hangman_art[g_lives_left];
+        DrawImage(framebuffer, image->pixels, image->width, image->height, 0, 0);
+    }
+    
+    // NOTE(tbt): draw the word
+    DrawString(framebuffer, g_guessed_word, 16, 16, 2, (Pixel){ 0, 0, 0 });
+    
+    // NOTE(tbt): draw already guessed letters
+    DrawString(framebuffer, g_guessed_letters, 16, WINDOW_DIMENSIONS_Y - (FONT_SIZE << 1) - 16, 1, (Pixel){ 0, 0, 0 });
+    
+    // NOTE(tbt): draw game state message
+    if(GAME_STATE_WON == g_game_state){
+        DrawString(framebuffer, "you won!\npress any\nkey to play\nagain", 60, 60, 2, (Pixel){ 0, 255, 0 });
+    }else if(GAME_STATE_LOST == g_game_state){
+        char message[4096] = {0};
+        snprintf(message, sizeof(message) - 1, "you lost...\n\nthe word was\n'%s'\n\npress any\nkey to try\nagain", g_word_to_guess);
+        DrawString(framebuffer, message, 60, 60, 2, (Pixel){ 0, 0, 255 });
+    }
+}
@@ -0,0 +1,157 @@
+////////////////////////////////
+//~NOTE(tbt): headless entry point
+
+// NOTE(tbt): builds without a window system, e.g. on linux:
+//
+//              headless_hangman [--seed <n>] [--frames <n>] [--dump <dir>] [--golden <dir>]
+//
+//            plays a game offscreen, guessing letters in order of how common they are until it is won or
+//            lost, then pressing a key to start again. each frame is drawn in to g_window_pixels by the same
+//            code as WM_PAINT. after each guess, --frames redraws are timed, and the frame is written to
+//            <dump dir>/<step>.ppm and compared to <golden dir>/<step>.ppm - so a --dump from a known good
+//            build is the golden images for later ones. exits with 1 if any frame differs. the word is
+//            picked with --seed (0 by default), so the same seed always plays the same game
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <stdint.h>    // NOTE(tbt): fixed size integers
+#include <stdbool.h>   // NOTE(tbt): bool, true, false
+#include <stddef.h>    // NOTE(tbt): NULL
+#include <stdio.h>     // NOTE(tbt): snprintf(), printf()
+#include <stdlib.h>    // NOTE(tbt): strtoul(), atoi()
+#include <time.h>      // NOTE(tbt): clock_gettime()
+
+#include "resources.h" // NOTE(tbt): generated header file containg artwork as array literals
+
+#include "../shared/rasteriser.c" // NOTE(tbt): drawing, shared with gtin8_utils
+#include "../shared/offscreen.c"  // NOTE(tbt): PPM dumps and golden images
+#include "game.c"                 // NOTE(tbt): everything but the window
+
+////////////////////////////////
+//~NOTE(tbt): offscreen game
+
+static uint64_t
+GetTimeNanoseconds(void){
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t)time.tv_sec*1000000000ull + time.tv_nsec;
+}
+
+// NOTE(tbt): draw the current state, then time, dump and check it as step_name
+static bool
+PlayOffscreenStep(const char *step_name,
+                  int redraws_count,
+                  char *dump_path,
+                  char *golden_path){
+    bool is_success = true;
+    
+    DrawGame(&g_framebuffer);
+    
+    uint64_t start = GetTimeNanoseconds();
+    for(int redraw_index = 0;
+        redraw_index < redraws_count;
+        redraw_index += 1){
+        DrawGame(&g_framebuffer);
+    }
+    uint64_t elapsed = GetTimeNanoseconds() - start;
+    
+    printf("step %-10s %9.1f us/redraw",
+           step_name,
+           (redraws_count > 0) ? elapsed / 1.0e3 / redraws_count : 0.0);
+    
+    char path[4096];
+    if(NULL != dump_path){
+        snprintf(path, sizeof(path), "%s/%s.ppm", dump_path, step_name);
+        if(!FramebufferWritePPM(&g_framebuffer, path)){
+            printf(", couldn't write %s", path);
+            is_success = false;
+        }
+    }
+    if(NULL != golden_path){
+        snprintf(path, sizeof(path), "%s/%s.ppm", golden_path, step_name);
+        FrameDifference difference;
+        if(FramebufferCompareToPPM(&g_framebuffer, path, &difference)){
+            printf(", matches golden");
+        }else if(!difference.is_golden_loaded){
+            printf(", couldn't read golden %s", path);
+            is_success = false;
+        }else{
+            printf(", DIFFERS from golden: %zu pixels (up to %d) in %d,%d - %d,%d",
+                   difference.pixels_count,
+                   difference.max_channel_difference,
+                   difference.bounds.min[0], difference.bounds.min[1],
+                   difference.bounds.max[0], difference.bounds.max[1]);
+            is_success = false;
+        }
+    }
+    printf("\n");
+    
+    return is_success;
+}
+
+static bool
+PlayOffscreen(int redraws_count,
+              char *dump_path,
+              char *golden_path){
+    bool is_success = true;
+    
+    ResetGame();
+    is_success = PlayOffscreenStep("start", redraws_count, dump_path, golden_path) && is_success;
+    
+    const char *guesses = "etaoinshrdlcumwfgypbvkjxqz";
+    for(const char *guess = guesses;
+        '\0' != *guess && GAME_STATE_PLAYING == g_game_state;
+        guess += 1){
+        GuessLetter(*guess);
+        char step_name[64];
+        snprintf(step_name, sizeof(step_name), "guess-%02d-%c", (int)(guess - guesses), *guess);
+        is_success = PlayOffscreenStep(step_name, redraws_count, dump_path, golden_path) && is_success;
+    }
+    
+    // NOTE(tbt): any key starts a new game once this one is over
+    ResetGame();
+    is_success = PlayOffscreenStep("reset", redraws_count, dump_path, golden_path) && is_success;
+    
+    return is_success;
+}
+
+////////////////////////////////
+//~NOTE(tbt): entry point
+
+int
+main(int argc,
+     char **argv){
+    int exit_code = 0;
+    
+    int redraws_count = 1;
+    char *dump_path = NULL;
+    char *golden_path = NULL;
+    bool is_usage_valid = true;
+    for(int arg_index = 1;
+        arg_index < argc && is_usage_valid;
+        arg_index += 2){
+        if(arg_index + 1 >= argc){
+            is_usage_valid = false;
+        }else if(0 == strcmp(argv[arg_index], "--seed")){
+            g_random_seed = strtoul(argv[arg_index + 1], NULL, 10);
+        }else if(0 == strcmp(argv[arg_index], "--frames")){
+            redraws_count = atoi(argv[arg_index + 1]);
+        }else if(0 == strcmp(argv[arg_index], "--dump")){
+            dump_path = argv[arg_index + 1];
+        }else if(0 == strcmp(argv[arg_index], "--golden")){
+            golden_path = argv[arg_index + 1];
+        }else{
+            is_usage_valid = false;
+        }
+    }
+    
+    if(!is_usage_valid){
+        fprintf(stderr, "usage: %s [--seed <n>] [--frames <n>] [--dump <dir>] [--golden <dir>]\n", argv[0]);
+        exit_code = 1;
+    }else if(!PlayOffscreen(redraws_count, dump_path, golden_path)){
+        exit_code = 1;
+    }
+    
+    return exit_code;
+}
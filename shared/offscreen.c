@@ -0,0 +1,120 @@
+////////////////////////////////
+//~NOTE(tbt): offscreen frames
+
+// NOTE(tbt): writing frames out, and checking them against golden images, for the headless builds of
+//            gtin8_utils and hangman - so drawing can be tested and profiled without a window. frames are
+//            binary PPMs (P6), which take no code to write and which anything can view. PPMs have no alpha
+//            channel, so the x component of each pixel is dropped
+//
+//            whoever includes this must include rasteriser.c first
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <stdio.h>     // NOTE(tbt): fopen(), fwrite(), fread(), fscanf()
+#include <stdlib.h>    // NOTE(tbt): malloc(), free()
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+// NOTE(tbt): how a frame differs from a golden image. if the golden image can't be read, or is a different
+//            size, every pixel counts as different
+typedef struct FrameDifference{
+    bool is_golden_loaded;
+    size_t pixels_count;        // NOTE(tbt): how many pixels differ at all
+    int max_channel_difference; // NOTE(tbt): the biggest difference in any one colour component
+    Rect bounds;                // NOTE(tbt): the smallest rect around every pixel which differs
+}FrameDifference;
+
+////////////////////////////////
+//~NOTE(tbt): PPM files
+
+static bool
+FramebufferWritePPM(Framebuffer *framebuffer,
+                    const char *path){
+    bool is_success = false;
+
+    FILE *file = fopen(path, "wb");
+    unsigned char *row = malloc((size_t)framebuffer->width*3);
+    if(NULL != file && NULL != row){
+        is_success = (fprintf(file, "P6\n%d %d\n255\n", framebuffer->width, framebuffer->height) > 0);
+        for(int y = 0;
+            y < framebuffer->height && is_success;
+            y += 1){
+            Pixel *pixels = &framebuffer->pixels[(size_t)y*framebuffer->width];
+            for(int x = 0;
+                x < framebuffer->width;
+                x += 1){
+                row[x*3 + 0] = pixels[x].r;
+                row[x*3 + 1] = pixels[x].g;
+                row[x*3 + 2] = pixels[x].b;
+            }
+            is_success = (fwrite(row, 3, framebuffer->width, file) == (size_t)framebuffer->width);
+        }
+    }
+    free(row);
+    if(NULL != file){
+        is_success = (0 == fclose(file)) && is_success;
+    }
+
+    return is_success;
+}
+
+// NOTE(tbt): returns true if the framebuffer matches the golden image at path exactly
+static bool
+FramebufferCompareToPPM(Framebuffer *framebuffer,
+                        const char *path,
+                        FrameDifference *difference){
+    memset(difference, 0, sizeof(*difference));
+
+    FILE *file = fopen(path, "rb");
+    unsigned char *row = malloc((size_t)framebuffer->width*3);
+    int width = 0;
+    int height = 0;
+    int max_value = 0;
+    if(NULL != file && NULL != row &&
+       3 == fscanf(file, "P6 %d %d %d", &width, &height, &max_value) &&
+       width == framebuffer->width &&
+       height == framebuffer->height &&
+       255 == max_value &&
+       EOF != fgetc(file)){ // NOTE(tbt): the one whitespace character after the header
+        difference->is_golden_loaded = true;
+        for(int y = 0;
+            y < framebuffer->height && difference->is_golden_loaded;
+            y += 1){
+            difference->is_golden_loaded = (fread(row, 3, framebuffer->width, file) == (size_t)framebuffer->width);
+            Pixel *pixels = &framebuffer->pixels[(size_t)y*framebuffer->width];
+            for(int x = 0;
+                x < framebuffer->width && difference->is_golden_loaded;
+                x += 1){
+                int channel_differences[3] = {
+                    abs((int)pixels[x].r - row[x*3 + 0]),
+                    abs((int)pixels[x].g - row[x*3 + 1]),
+                    abs((int)pixels[x].b - row[x*3 + 2]),
+                };
+                int channel_difference = channel_differences[0];
+                if(channel_differences[1] > channel_difference){ channel_difference = channel_differences[1]; }
+                if(channel_differences[2] > channel_difference){ channel_difference = channel_differences[2]; }
+                if(channel_difference > 0){
+                    difference->pixels_count += 1;
+                    if(channel_difference > difference->max_channel_difference){
+                        difference->max_channel_difference = channel_difference;
+                    }
+                    difference->bounds = RectUnion(difference->bounds, (Rect){ { x, y }, { x + 1, y + 1 } });
+                }
+            }
+        }
+    }
+    free(row);
+    if(NULL != file){
+        fclose(file);
+    }
+
+    if(!difference->is_golden_loaded){
+        difference->pixels_count = (size_t)framebuffer->width*framebuffer->height;
+        difference->max_channel_difference = 255;
+        difference->bounds = (Rect){ .max = { framebuffer->width, framebuffer->height } };
+    }
+
+    return (0 == difference->pixels_count);
+}
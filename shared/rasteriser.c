@@ -0,0 +1,528 @@
+////////////////////////////////
+//~NOTE(tbt): rasteriser
+
+// NOTE(tbt): the drawing primitives shared by gtin8_utils and hangman. everything is drawn in to a
+//            Framebuffer, and clipped to the rect on top of its clip stack - or the whole framebuffer if the
+//            stack is empty. each primitive intersects what it draws with that once, up front, and then
+//            works along contiguous rows, so nothing is bounds checked per pixel
+//
+//            whoever includes this must already have FONT_SIZE and g_font[128][FONT_SIZE], the bitmap font
+//            which text is drawn with
+
+////////////////////////////////
+//~NOTE(tbt): header files
+
+#include <stdint.h>    // NOTE(tbt): fixed size integers
+#include <stdbool.h>   // NOTE(tbt): bool, true, false
+#include <string.h>    // NOTE(tbt): memset(), memcpy()
+
+// NOTE(tbt): gtin8_utils gets these from its platform layer already
+#if !defined(ARCH_X86) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+# define ARCH_X86 1
+# if defined(_MSC_VER)
+#  include <intrin.h>     // NOTE(tbt): __cpuid(), _xgetbv() and SSE2/AVX2 intrinsics
+# else
+#  include <immintrin.h>  // NOTE(tbt): SSE2/AVX2 intrinsics
+# endif
+#endif
+
+#if !defined(TARGET_AVX2)
+# if defined(_MSC_VER)
+#  define TARGET_AVX2
+# else
+#  define TARGET_AVX2 __attribute__((target("avx2")))
+# endif
+#endif
+
+////////////////////////////////
+//~NOTE(tbt): misc macros and constants
+
+enum{
+    MAX_CLIP_STACK_DEPTH = 16,
+    GLYPH_CACHE_SCALES_COUNT = 4, // NOTE(tbt): scale factors 0 to 3 are cached - anything bigger is drawn a pixel at a time
+};
+
+////////////////////////////////
+//~NOTE(tbt): types
+
+typedef struct Pixel{
+    uint8_t b; // NOTE(tbt): blue colour component
+    uint8_t g; // NOTE(tbt): green colour component
+    uint8_t r; // NOTE(tbt): red colour component
+    uint8_t x; // NOTE(tbt): pad to align to 32 bits
+}Pixel;
+
+// NOTE(tbt): pixels from min up to but not including max
+typedef struct Rect{
+    int min[2];
+    int max[2];
+}Rect;
+
+typedef struct Framebuffer{
+    Pixel *pixels; // NOTE(tbt): width*height pixels, top row first
+    int width;
+    int height;
+    
+    // NOTE(tbt): each rect is already intersected with the ones below it, so the top is all that matters
+    Rect clip_stack[MAX_CLIP_STACK_DEPTH];
+    int clip_stack_count;
+}Framebuffer;
+
+////////////////////////////////
+//~NOTE(tbt): global variables
+
+// NOTE(tbt): every glyph of the font expanded for each scale factor to a mask per pixel - all ones where the
+//            glyph is set and zero where it isn't - so drawing a glyph is a masked store of a row at a time
+//            rather than picking bits out of the font for each pixel. scale factor n is 128 glyphs of
+//            (FONT_SIZE << n) squared masks, after all of the smaller scale factors. each is filled in the
+//            first time a string is drawn at it
+static uint32_t g_glyph_cache[128*FONT_SIZE*FONT_SIZE*(1 + 4 + 16 + 64)];
+static bool g_is_glyph_cache_scale_filled[GLYPH_CACHE_SCALES_COUNT];
+
+////////////////////////////////
+//~NOTE(tbt): rects
+
+static bool
+RectIsEmpty(Rect rect){
+    return rect.min[0] >= rect.max[0] || rect.min[1] >= rect.max[1];
+}
+
+static Rect
+RectIntersection(Rect a,
+                 Rect b){
+    Rect result = {
+        .min = { (a.min[0] > b.min[0]) ? a.min[0] : b.min[0], (a.min[1] > b.min[1]) ? a.min[1] : b.min[1] },
+        .max = { (a.max[0] < b.max[0]) ? a.max[0] : b.max[0], (a.max[1] < b.max[1]) ? a.max[1] : b.max[1] },
+    };
+    return result;
+}
+
+// NOTE(tbt): the smallest rect containing both. an empty rect doesn't count
+static Rect
+RectUnion(Rect a,
+          Rect b){
+    Rect result = a;
+    if(RectIsEmpty(a)){
+        result = b;
+    }else if(!RectIsEmpty(b)){
+        result = (Rect){
+            .min = { (a.min[0] < b.min[0]) ? a.min[0] : b.min[0], (a.min[1] < b.min[1]) ? a.min[1] : b.min[1] },
+            .max = { (a.max[0] > b.max[0]) ? a.max[0] : b.max[0], (a.max[1] > b.max[1]) ? a.max[1] : b.max[1] },
+        };
+    }
+    return result;
+}
+
+////////////////////////////////
+//~NOTE(tbt): clipping
+
+// NOTE(tbt): the pixels drawing is allowed to touch - the whole framebuffer, or the top of the clip stack
+static Rect
+FramebufferClipRect(Framebuffer *framebuffer){
+    Rect result = { .max = { framebuffer->width, framebuffer->height } };
+    if(framebuffer->clip_stack_count > 0){
+        int top = (framebuffer->clip_stack_count < MAX_CLIP_STACK_DEPTH) ? framebuffer->clip_stack_count : MAX_CLIP_STACK_DEPTH;
+        result = framebuffer->clip_stack[top - 1];
+    }
+    return result;
+}
+
+// NOTE(tbt): restrict drawing to the part of rect inside the current clip rect, until the matching pop.
+//            pushes past MAX_CLIP_STACK_DEPTH are counted, so pops still match up, but don't clip any further
+static void
+FramebufferPushClip(Framebuffer *framebuffer,
+                    Rect rect){
+    if(framebuffer->clip_stack_count < MAX_CLIP_STACK_DEPTH){
+        framebuffer->clip_stack[framebuffer->clip_stack_count] = RectIntersection(FramebufferClipRect(framebuffer), rect);
+    }
+    framebuffer->clip_stack_count += 1;
+}
+
+static void
+FramebufferPopClip(Framebuffer *framebuffer){
+    if(framebuffer->clip_stack_count > 0){
+        framebuffer->clip_stack_count -= 1;
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): fills and blits
+
+#if defined(_MSC_VER)
+// NOTE(tbt): MSVC has no cpuid builtin which checks for OS support of the AVX registers, so do it manually
+static bool
+RasteriserIsAVX2Supported(void){
+    bool result = false;
+# if ARCH_X86
+    int info[4];
+    __cpuid(info, 0);
+    if(info[0] >= 7){
+        __cpuid(info, 1);
+        bool is_os_saving_ymm = false;
+        if(info[2] & (1 << 27)){ // NOTE(tbt): OSXSAVE
+            is_os_saving_ymm = (6 == (_xgetbv(0) & 6));
+        }
+        __cpuidex(info, 7, 0);
+        result = is_os_saving_ymm && (info[1] & (1 << 5));
+    }
+# endif
+    return result;
+}
+#elif ARCH_X86
+static bool
+RasteriserIsAVX2Supported(void){
+    return __builtin_cpu_supports("avx2");
+}
+#endif
+
+// NOTE(tbt): set count contiguous pixels to colour. colours with all four bytes the same (black and white)
+//            go to memset, which libc already has as fast as it gets
+static void
+FillPixels(Pixel *pixels,
+           int count,
+           Pixel colour){
+    if(colour.b == colour.g && colour.b == colour.r && colour.b == colour.x){
+        memset(pixels, colour.b, (size_t)count*sizeof(Pixel));
+    }else{
+        int i = 0;
+#if ARCH_X86
+        uint32_t colour_u32;
+        memcpy(&colour_u32, &colour, sizeof(colour_u32));
+        __m128i colour_x4 = _mm_set1_epi32(colour_u32);
+        for(;
+            i + 16 <= count;
+            i += 16){
+            _mm_storeu_si128((__m128i *)&pixels[i +  0], colour_x4);
+            _mm_storeu_si128((__m128i *)&pixels[i +  4], colour_x4);
+            _mm_storeu_si128((__m128i *)&pixels[i +  8], colour_x4);
+            _mm_storeu_si128((__m128i *)&pixels[i + 12], colour_x4);
+        }
+        for(;
+            i + 4 <= count;
+            i += 4){
+            _mm_storeu_si128((__m128i *)&pixels[i], colour_x4);
+        }
+#endif
+        for(;
+            i < count;
+            i += 1){
+            pixels[i] = colour;
+        }
+    }
+}
+
+static void
+DrawRectangleFill(Framebuffer *framebuffer,
+                  Pixel col,
+                  int min[2],
+                  int max[2]){
+    Rect bounds = RectIntersection(FramebufferClipRect(framebuffer), (Rect){ { min[0], min[1] }, { max[0], max[1] } });
+    if(!RectIsEmpty(bounds)){
+        int width = bounds.max[0] - bounds.min[0];
+        if(width == framebuffer->width){
+            // NOTE(tbt): whole rows are contiguous, so fill them all in one go
+            FillPixels(&framebuffer->pixels[bounds.min[1]*framebuffer->width], width*(bounds.max[1] - bounds.min[1]), col);
+        }else{
+            for(int y = bounds.min[1];
+                y < bounds.max[1];
+                y += 1){
+                FillPixels(&framebuffer->pixels[bounds.min[0] + y*framebuffer->width], width, col);
+            }
+        }
+    }
+}
+
+// NOTE(tbt): fill everything inside the clip rect
+static void
+FramebufferFill(Framebuffer *framebuffer,
+                Pixel colour){
+    Rect bounds = FramebufferClipRect(framebuffer);
+    DrawRectangleFill(framebuffer, colour, bounds.min, bounds.max);
+}
+
+static void
+FramebufferClear(Framebuffer *framebuffer){
+    FramebufferFill(framebuffer, (Pixel){ 0 });
+}
+
+// NOTE(tbt): copy a width*height image, top row first, with its top left corner at x, y
+static void
+DrawImage(Framebuffer *framebuffer,
+          const Pixel *image_pixels,
+          int image_width,
+          int image_height,
+          int x, int y){
+    Rect bounds = RectIntersection(FramebufferClipRect(framebuffer), (Rect){ { x, y }, { x + image_width, y + image_height } });
+    if(!RectIsEmpty(bounds)){
+        int width = bounds.max[0] - bounds.min[0];
+        const Pixel *source = &image_pixels[(bounds.min[0] - x) + (bounds.min[1] - y)*image_width];
+        Pixel *destination = &framebuffer->pixels[bounds.min[0] + bounds.min[1]*framebuffer->width];
+        if(width == image_width && width == framebuffer->width){
+            memcpy(destination, source, (size_t)width*(bounds.max[1] - bounds.min[1])*sizeof(Pixel));
+        }else{
+            for(int row = bounds.min[1];
+                row < bounds.max[1];
+                row += 1){
+                memcpy(destination, source, (size_t)width*sizeof(Pixel));
+                source += image_width;
+                destination += framebuffer->width;
+            }
+        }
+    }
+}
+
+////////////////////////////////
+//~NOTE(tbt): glyph cache
+
+// NOTE(tbt): the (FONT_SIZE << scale_factor) squared masks of each glyph one after the other, top row
+//            first. NULL for scale factors which aren't cached
+static const uint32_t *
+GlyphCacheMasksFromScale(int scale_factor){
+    const uint32_t *result = NULL;
+    if(0 <= scale_factor && scale_factor < GLYPH_CACHE_SCALES_COUNT){
+        int size = FONT_SIZE << scale_factor;
+        uint32_t *masks = &g_glyph_cache[128*FONT_SIZE*FONT_SIZE*(((1 << (2*scale_factor)) - 1) / 3)];
+        if(!g_is_glyph_cache_scale_filled[scale_factor]){
+            for(int c = 0;
+                c < 128;
+                c += 1){
+                for(int y = 0;
+                    y < size;
+                    y += 1){
+                    unsigned char row = g_font[c][y >> scale_factor];
+                    uint32_t *mask = &masks[(c*size + y)*size];
+                    for(int x = 0;
+                        x < size;
+                        x += 1){
+                        mask[x] = (row & (1 << (x >> scale_factor))) ? 0xffffffff : 0;
+                    }
+                }
+            }
+            g_is_glyph_cache_scale_filled[scale_factor] = true;
+        }
+        result = masks;
+    }
+    return result;
+}
+
+// NOTE(tbt): set each pixel of a width*height block where the mask is set. strides are in elements
+static void
+GlyphBlitScalar(Pixel *pixels,
+                int pixels_stride,
+                const uint32_t *mask,
+                int mask_stride,
+                int width,
+                int height,
+                Pixel colour){
+    for(int y = 0;
+        y < height;
+        y += 1){
+        for(int x = 0;
+            x < width;
+            x += 1){
+            if(mask[x]){
+                pixels[x] = colour;
+            }
+        }
+        pixels += pixels_stride;
+        mask += mask_stride;
+    }
+}
+
+#if ARCH_X86
+
+// NOTE(tbt): SSE2 has no masked store which isn't also non-temporal, so blend in to what is already there
+static void
+GlyphBlitSSE2(Pixel *pixels,
+              int pixels_stride,
+              const uint32_t *mask,
+              int mask_stride,
+              int width,
+              int height,
+              Pixel colour){
+    uint32_t colour_u32;
+    memcpy(&colour_u32, &colour, sizeof(colour_u32));
+    __m128i colour_x4 = _mm_set1_epi32(colour_u32);
+    for(int y = 0;
+        y < height;
+        y += 1){
+        int x = 0;
+        for(;
+            x + 4 <= width;
+            x += 4){
+            __m128i m = _mm_loadu_si128((const __m128i *)&mask[x]);
+            __m128i destination = _mm_loadu_si128((const __m128i *)&pixels[x]);
+            destination = _mm_or_si128(_mm_andnot_si128(m, destination), _mm_and_si128(m, colour_x4));
+            _mm_storeu_si128((__m128i *)&pixels[x], destination);
+        }
+        for(;
+            x < width;
+            x += 1){
+            if(mask[x]){
+                pixels[x] = colour;
+            }
+        }
+        pixels += pixels_stride;
+        mask += mask_stride;
+    }
+}
+
+// NOTE(tbt): the end of a clipped row is a masked store too, with the lanes past the end masked off - the
+//            masked off lanes of the destination aren't touched, so can be past the end of the framebuffer
+static TARGET_AVX2 void
+GlyphBlitAVX2(Pixel *pixels,
+              int pixels_stride,
+              const uint32_t *mask,
+              int mask_stride,
+              int width,
+              int height,
+              Pixel colour){
+    uint32_t colour_u32;
+    memcpy(&colour_u32, &colour, sizeof(colour_u32));
+    __m256i colour_x8 = _mm256_set1_epi32(colour_u32);
+    __m256i lane_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i tail_lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(width & 7), lane_indices);
+    int tail_start = width & ~7;
+    for(int y = 0;
+        y < height;
+        y += 1){
+        for(int x = 0;
+            x < tail_start;
+            x += 8){
+            __m256i m = _mm256_loadu_si256((const __m256i *)&mask[x]);
+            _mm256_maskstore_epi32((int *)&pixels[x], m, colour_x8);
+        }
+        if(tail_start < width){
+            __m256i m = _mm256_maskload_epi32((const int *)&mask[tail_start], tail_lanes);
+            _mm256_maskstore_epi32((int *)&pixels[tail_start], m, colour_x8);
+        }
+        pixels += pixels_stride;
+        mask += mask_stride;
+    }
+}
+
+#endif
+
+typedef void GlyphBlitFunction(Pixel *, int, const uint32_t *, int, int, int, Pixel);
+
+// NOTE(tbt): the best kernel the cpu supports, picked the first time it is asked for
+static GlyphBlitFunction *
+GlyphBlitGetKernel(void){
+    static GlyphBlitFunction *kernel = NULL;
+    if(NULL == kernel){
+#if ARCH_X86
+        kernel = RasteriserIsAVX2Supported() ? GlyphBlitAVX2 : GlyphBlitSSE2;
+#else
+        kernel = GlyphBlitScalar;
+#endif
+    }
+    return kernel;
+}
+
+static void
+GlyphBlit(Pixel *pixels,
+          int pixels_stride,
+          const uint32_t *mask,
+          int mask_stride,
+          int width,
+          int height,
+          Pixel colour){
+    GlyphBlitGetKernel()(pixels, pixels_stride, mask, mask_stride, width, height, colour);
+}
+
+// NOTE(tbt): fill in the glyph cache for a scale factor and pick the blit kernel, if that hasn't been done
+//            already. drawing strings from more than one thread at once needs this done first, on one thread
+static void
+GlyphCachePrepare(int scale_factor){
+    GlyphCacheMasksFromScale(scale_factor);
+    GlyphBlitGetKernel();
+}
+
+////////////////////////////////
+//~NOTE(tbt): text
+
+static void
+MeasureString(const char *string,
+              int x, int y,
+              int scale_factor,
+              int padding,
+              int result_min[2],
+              int result_max[2]){
+    int row_start = x;
+    
+    result_min[0] = x - padding;
+    result_min[1] = y - padding;
+    result_max[0] = x;
+    result_max[1] = y + (FONT_SIZE << scale_factor);
+    
+    char c;
+    while(c = *string++){
+        if('\n' == c){
+            y += (FONT_SIZE << scale_factor);
+            x = row_start;
+        }else if(c < 128){
+            x += (FONT_SIZE << scale_factor);
+        }
+        
+        if(x > result_max[0]){
+            result_max[0] = x;
+        }
+        
+        if(y > result_max[1]){
+            result_max[1] = y;
+        }
+    }
+    
+    result_max[0] += padding;
+    result_max[1] += padding;
+}
+
+// NOTE(tbt): render a string using the bitmap font. each glyph is clipped once, then blitted from the glyph
+//            cache
+static void
+DrawString(Framebuffer *framebuffer,
+           const char *string,
+           int x, int y,
+           int scale_factor,
+           Pixel colour){
+    int row_start = x;
+    int glyph_size = FONT_SIZE << scale_factor;
+    Rect bounds = FramebufferClipRect(framebuffer);
+    const uint32_t *glyph_masks = GlyphCacheMasksFromScale(scale_factor);
+    
+    char c;
+    while(c = *string++){
+        if(c == '\n'){
+            y += glyph_size;
+            x = row_start;
+        }else if(c < 128){
+            Rect glyph_rect = { { x, y }, { x + glyph_size, y + glyph_size } };
+            Rect visible = RectIntersection(glyph_rect, bounds);
+            if(c >= 0 && !RectIsEmpty(visible)){
+                int offset_x = visible.min[0] - x;
+                int offset_y = visible.min[1] - y;
+                Pixel *pixels = &framebuffer->pixels[visible.min[0] + visible.min[1]*framebuffer->width];
+                int width = visible.max[0] - visible.min[0];
+                int height = visible.max[1] - visible.min[1];
+                if(NULL != glyph_masks){
+                    const uint32_t *mask = &glyph_masks[(c*glyph_size + offset_y)*glyph_size + offset_x];
+                    GlyphBlit(pixels, framebuffer->width, mask, glyph_size, width, height, colour);
+                }else{
+                    for(int _y = 0;
+                        _y < height;
+                        _y += 1){
+                        unsigned char row = g_font[c][(offset_y + _y) >> scale_factor];
+                        for(int _x = 0;
+                            _x < width;
+                            _x += 1){
+                            if(row & (1 << ((offset_x + _x) >> scale_factor))){
+                                pixels[_x + _y*framebuffer->width] = colour;
+                            }
+                        }
+                    }
+                }
+            }
+            x += glyph_size;
+        }
+    }
+}